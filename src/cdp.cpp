@@ -34,14 +34,14 @@
 /* Libraries */
 
 #include "cdp.h"
+#include "cdp_bits.h"
 
 /*****************************************************************************/
 
 /* Constants */
 
-#define LOGIC_LEVEL_LOW  0
-#define LOGIC_LEVEL_HIGH 1
-#define INITIAL_SIGNAL_LEVEL LOGIC_LEVEL_HIGH
+// Frames encoded in parallel lanes by encode_batch()
+#define BATCH_LANES 4
 
 /*****************************************************************************/
 
@@ -64,6 +64,466 @@ static inline uint8_t GET_BIT(const uint16_t data, const uint8_t bit_n)
 static inline uint8_t GET_BIT(const uint32_t data, const uint8_t bit_n)
 {   return ((data >> bit_n) & 0x01);   }
 
+/**
+  * @brief  Encode a byte into its 16 chips (LSB-first, same layout as
+  * encode() output) for all the bits at once: the signal level after each
+  * bit is the prefix xor of the data bits with the current signal level,
+  * and each bit is encoded as "not(level), level".
+  * @param  data_byte Byte value to be encoded.
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Encoded chips.
+  */
+static inline uint16_t ENCODE_BYTE_CHIPS(const uint8_t data_byte,
+        uint8_t* current_signal_level)
+{
+    uint32_t levels = prefix_xor32(data_byte) & 0xFF;
+    if(*current_signal_level)
+        levels = levels ^ 0xFF;
+    *current_signal_level = (uint8_t)(levels >> 7);
+    return (uint16_t)(expand_even64(~levels & 0xFF) |
+            (expand_even64(levels) << 1));
+}
+
+/**
+  * @brief  Decode the 16 chips of a byte (LSB-first, same layout as
+  * encode() output) for all the bits at once, with the same rules as
+  * decode_bit(): first and second chips of each bit are gathered in two
+  * bytes, the signal level after each bit is LOW just for "10" chips and
+  * each data bit is the xor of the levels before and after it.
+  * @param  chips Encoded chips.
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Decoded byte.
+  */
+static inline uint8_t DECODE_BYTE_CHIPS(const uint16_t chips,
+        uint8_t* current_signal_level)
+{
+    uint32_t first_chips = compress_even64(chips);
+    uint32_t second_chips = compress_even64(chips >> 1);
+    uint32_t levels = ~(first_chips & ~second_chips) & 0xFF;
+    uint8_t data_byte = (uint8_t)(levels ^ ((levels << 1) |
+            *current_signal_level));
+    *current_signal_level = (uint8_t)(levels >> 7);
+    return data_byte;
+}
+
+/**
+  * @brief  Decode 64 chips into 4 bytes at once, with the same rules as
+  * DECODE_BYTE_CHIPS().
+  * @param  chips Encoded chips (LSB-first, same layout as encode() output).
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Decoded bytes (first byte in the low bits).
+  */
+static inline uint32_t DECODE_WORD_CHIPS(const uint64_t chips,
+        uint8_t* current_signal_level)
+{
+    uint32_t first_chips = compress_even64(chips);
+    uint32_t second_chips = compress_even64(chips >> 1);
+    uint32_t levels = ~(first_chips & ~second_chips);
+    uint32_t data = levels ^ ((levels << 1) | *current_signal_level);
+    *current_signal_level = (uint8_t)(levels >> 31);
+    return data;
+}
+
+/**
+  * @brief  Encode up to 32 symbols (data bits and J/K code violations) into
+  * their chips at once. A J symbol keeps the signal level for the whole bit
+  * (no transition at start nor middle) and a K symbol inverts it at start
+  * (no middle transition), so taking J as data bit 0 and K as data bit 1
+  * the signal level after each symbol is still the prefix xor of the bits,
+  * and the first chip of a symbol is "not(level)" for data bits and
+  * "level" for J/K symbols.
+  * @param  data Symbols bits (LSb first; 0 for J and 1 for K symbols).
+  * @param  jk Symbols J/K flags (bit set for J/K symbols).
+  * @param  num_bits Number of symbols (1 to 32).
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Encoded chips (LSB-first, 2 chips for each symbol).
+  */
+static inline uint64_t ENCODE_SYMBOLS_CHIPS(const uint32_t data,
+        const uint32_t jk, const uint8_t num_bits,
+        uint8_t* current_signal_level)
+{
+    uint32_t levels = prefix_xor32(data);
+    if(*current_signal_level)
+        levels = ~levels;
+    *current_signal_level = (uint8_t)((levels >> (num_bits - 1)) & 0x01);
+    return (expand_even64(~levels ^ jk) | (expand_even64(levels) << 1));
+}
+
+/**
+  * @brief  Decode up to 32 symbols from their chips at once. Symbols with
+  * both chips equal are J/K code violations (J if the chips keep previous
+  * signal level, K otherwise), and the signal level after each symbol is
+  * its second chip.
+  * @param  chips Encoded chips (LSB-first, 2 chips for each symbol).
+  * @param  num_bits Number of symbols (1 to 32).
+  * @param  jk Pointer to store symbols J/K flags (bit set for J/K).
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Symbols bits (0 for J and 1 for K symbols).
+  */
+static inline uint32_t DECODE_SYMBOLS_CHIPS(const uint64_t chips,
+        const uint8_t num_bits, uint32_t* jk, uint8_t* current_signal_level)
+{
+    uint32_t first_chips = compress_even64(chips);
+    uint32_t levels = compress_even64(chips >> 1);
+    uint32_t data = levels ^ ((levels << 1) | *current_signal_level);
+
+    *jk = ~(first_chips ^ levels);
+    *current_signal_level = (uint8_t)((levels >> (num_bits - 1)) & 0x01);
+    return data;
+}
+
+/**
+  * @brief  Encode data replicating each chip K times, with K known at
+  * compile time. Chips are spread K bits apart (bit deposit, PDEP when
+  * BMI2 is available) and each one is replicated by multiplying by
+  * (2^K - 1), which fills every K bits field without carries, so a group
+  * of chips is expanded at once.
+  * @param  data_in Pointer to input data to be encode.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array (data_in_len*2*K bytes).
+  * @param  msb_first Output bits order in each byte (MSb bit first).
+  */
+template <uint8_t K>
+static void ENCODE_EXPAND(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const bool msb_first)
+{
+    const uint8_t GROUP_CHIPS = (56 / K) < 16 ? (56 / K) : 16;
+    const uint64_t FILL = (1ULL << K) - 1;
+    uint8_t current_signal_level = INITIAL_SIGNAL_LEVEL;
+    uint64_t acc = 0;
+    uint8_t acc_bits = 0;
+    size_t out_i = 0;
+
+    // Start bit of each K bits field of a group
+    #if defined(__BMI2__)
+        uint64_t deposit_mask = 0;
+        for(uint8_t c = 0; c < GROUP_CHIPS; c++)
+            deposit_mask = deposit_mask | (1ULL << (c*K));
+    #endif
+
+    for(size_t i = 0; i < data_in_len; i++)
+    {
+        uint32_t chips = ENCODE_BYTE_CHIPS(data_in[i], &current_signal_level);
+        uint8_t chips_left = 16;
+
+        while(chips_left > 0)
+        {
+            uint8_t n = (chips_left < GROUP_CHIPS) ? chips_left : GROUP_CHIPS;
+            uint64_t spread = 0;
+
+            // Deposit each chip at the start of its K bits field
+            #if defined(__BMI2__)
+                spread = _pdep_u64(chips & ((1ULL << n) - 1), deposit_mask);
+            #else
+                for(uint8_t c = 0; c < n; c++)
+                {
+                    spread = spread |
+                            ((uint64_t)((chips >> c) & 0x01) << (c*K));
+                }
+            #endif
+            acc = acc | ((spread * FILL) << acc_bits);
+            acc_bits = acc_bits + (n * K);
+            chips = chips >> n;
+            chips_left = chips_left - n;
+
+            // Output complete bytes
+            while(acc_bits >= 8)
+            {
+                if(msb_first)
+                    data_out[out_i] = reverse_bits8((uint8_t)acc);
+                else
+                    data_out[out_i] = (uint8_t)acc;
+                out_i = out_i + 1;
+                acc = acc >> 8;
+                acc_bits = acc_bits - 8;
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Gather integer values into a 64 bits lane (first value in the
+  * low bits), i.e. up to 4 uint16, 2 uint32 or 1 uint64 values.
+  * @param  values Pointer to the values.
+  * @param  num_values Number of values (up to 8 / sizeof(T)).
+  * @return Lane word.
+  */
+template <typename T>
+static inline uint64_t LOAD_LANE(const T* values, const uint8_t num_values)
+{
+    uint64_t lane = 0;
+    for(uint8_t k = 0; k < num_values; k++)
+        lane = lane | ((uint64_t)values[k] << (8*sizeof(T)*k));
+    return lane;
+}
+
+/**
+  * @brief  Scatter a 64 bits lane into integer values (inverse of
+  * LOAD_LANE()).
+  * @param  values Pointer to store the values.
+  * @param  lane Lane word.
+  * @param  num_values Number of values (up to 8 / sizeof(T)).
+  */
+template <typename T>
+static inline void STORE_LANE(T* values, const uint64_t lane,
+        const uint8_t num_values)
+{
+    for(uint8_t k = 0; k < num_values; k++)
+        values[k] = (T)(lane >> (8*sizeof(T)*k));
+}
+
+/**
+  * @brief  Reverse the bytes order of each value of a lane (host to
+  * network byte order and back), swapping bytes, then 16 bits halves and
+  * then 32 bits halves as needed by the value size (all values at once).
+  * @param  lane Lane word.
+  * @return Lane with the bytes of each value reversed.
+  */
+template <typename T>
+static inline uint64_t BSWAP_LANE(uint64_t lane)
+{
+    if(sizeof(T) == 8)
+        return bswap64(lane);
+    lane = ((lane & 0xFF00FF00FF00FF00ULL) >> 8) |
+            ((lane & 0x00FF00FF00FF00FFULL) << 8);
+    if(sizeof(T) == 4)
+    {
+        lane = ((lane & 0xFFFF0000FFFF0000ULL) >> 16) |
+                ((lane & 0x0000FFFF0000FFFFULL) << 16);
+    }
+    return lane;
+}
+
+/**
+  * @brief  Encode integer values in network byte order (most significant
+  * byte first), swapping the bytes (and reversing the bits of each byte
+  * if requested) of 8 bytes at once in a register before encoding them,
+  * so no byte swapped copy of the values is needed.
+  * @param  values Pointer to the values to encode.
+  * @param  num_values Number of values.
+  * @param  data_out Pointer to output data array (num_values*sizeof(T)*2
+  * bytes).
+  * @param  msb_first Send each byte MSb first.
+  * @param  current_signal_level Pointer to current logic signal level.
+  */
+template <typename T>
+static void ENCODE_BE(const T* values, const size_t num_values,
+        uint8_t* data_out, const bool msb_first,
+        uint8_t* current_signal_level)
+{
+    const uint8_t LANE_VALUES = 8 / sizeof(T);
+
+    for(size_t i = 0; i < num_values; i = i + LANE_VALUES)
+    {
+        uint8_t n = (num_values - i < LANE_VALUES) ?
+                (uint8_t)(num_values - i) : LANE_VALUES;
+        uint8_t len = n * sizeof(T);
+        uint8_t low_len = (len < 4) ? len : 4;
+        uint64_t lane = BSWAP_LANE<T>(LOAD_LANE(values + i, n));
+
+        if(msb_first)
+            lane = reverse_bits8x8(lane);
+        store_le64_len(data_out, ENCODE_SYMBOLS_CHIPS((uint32_t)lane, 0,
+                low_len*8, current_signal_level), low_len*2);
+        if(len > 4)
+        {
+            store_le64_len(data_out + 8, ENCODE_SYMBOLS_CHIPS(
+                    (uint32_t)(lane >> 32), 0, (len - 4)*8,
+                    current_signal_level), (len - 4)*2);
+        }
+        data_out = data_out + len*2;
+    }
+}
+
+/**
+  * @brief  Decode integer values sent in network byte order (inverse of
+  * ENCODE_BE()), decoding 8 bytes at once and swapping them in a register.
+  * @param  data_in Pointer to encoded data (num_values*sizeof(T)*2 bytes).
+  * @param  num_values Number of values.
+  * @param  values Pointer to store the decoded values.
+  * @param  msb_first Each byte was sent MSb first.
+  * @param  current_signal_level Pointer to current logic signal level.
+  */
+template <typename T>
+static void DECODE_BE(const uint8_t* data_in, const size_t num_values,
+        T* values, const bool msb_first, uint8_t* current_signal_level)
+{
+    const uint8_t LANE_VALUES = 8 / sizeof(T);
+
+    for(size_t i = 0; i < num_values; i = i + LANE_VALUES)
+    {
+        uint8_t n = (num_values - i < LANE_VALUES) ?
+                (uint8_t)(num_values - i) : LANE_VALUES;
+        uint8_t len = n * sizeof(T);
+        uint64_t lane = 0;
+
+        if(len == 8)
+        {
+            lane = DECODE_WORD_CHIPS(load_le64(data_in),
+                    current_signal_level);
+            lane = lane | ((uint64_t)DECODE_WORD_CHIPS(load_le64(
+                    data_in + 8), current_signal_level) << 32);
+        }
+        else
+        {
+            for(uint8_t k = 0; k < len; k++)
+            {
+                uint16_t chips = (uint16_t)(data_in[2*k] |
+                        (data_in[2*k + 1] << 8));
+                lane = lane | ((uint64_t)DECODE_BYTE_CHIPS(chips,
+                        current_signal_level) << (8*k));
+            }
+        }
+        if(msb_first)
+            lane = reverse_bits8x8(lane);
+        STORE_LANE(values + i, BSWAP_LANE<T>(lane), n);
+        data_in = data_in + len*2;
+    }
+}
+
+/**
+  * @brief  Encode 32 bits of two different frames at once (each one with its
+  * own signal level), with the same rules as ENCODE_BYTE_CHIPS(): prefix
+  * xor, levels inversion and chips expansion are done in the two 64 bits
+  * lanes of a SSE2 register (scalar kernel when there is no SSE2).
+  * @param  data_a First frame data bits.
+  * @param  data_b Second frame data bits.
+  * @param  level_a First frame signal level.
+  * @param  level_b Second frame signal level.
+  * @param  chips_b Pointer to store the second frame chips.
+  * @return First frame chips (64 chips, LSB-first).
+  */
+static inline uint64_t ENCODE_PAIR_CHIPS(const uint32_t data_a,
+        const uint32_t data_b, const uint8_t level_a, const uint8_t level_b,
+        uint64_t* chips_b)
+{
+    #if defined(__SSE2__)
+        const __m128i mask32 = _mm_set1_epi64x(0xFFFFFFFFLL);
+        __m128i x = _mm_set_epi64x(data_b, data_a);
+        __m128i chips;
+
+        // Levels after each bit
+        x = _mm_xor_si128(x, _mm_slli_epi64(x, 1));
+        x = _mm_xor_si128(x, _mm_slli_epi64(x, 2));
+        x = _mm_xor_si128(x, _mm_slli_epi64(x, 4));
+        x = _mm_xor_si128(x, _mm_slli_epi64(x, 8));
+        x = _mm_xor_si128(x, _mm_slli_epi64(x, 16));
+        x = _mm_xor_si128(x, _mm_set_epi64x(-(int64_t)level_b,
+                -(int64_t)level_a));
+        x = _mm_and_si128(x, mask32);
+
+        // Spread them to the even bits
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 16)),
+                _mm_set1_epi64x(0x0000FFFF0000FFFFLL));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 8)),
+                _mm_set1_epi64x(0x00FF00FF00FF00FFLL));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 4)),
+                _mm_set1_epi64x(0x0F0F0F0F0F0F0F0FLL));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 2)),
+                _mm_set1_epi64x(0x3333333333333333LL));
+        x = _mm_and_si128(_mm_or_si128(x, _mm_slli_epi64(x, 1)),
+                _mm_set1_epi64x(0x5555555555555555LL));
+
+        // Chips "not(level), level" of each bit
+        chips = _mm_or_si128(_mm_xor_si128(x,
+                _mm_set1_epi64x(0x5555555555555555LL)),
+                _mm_slli_epi64(x, 1));
+        *chips_b = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(chips,
+                chips));
+        return (uint64_t)_mm_cvtsi128_si64(chips);
+    #else
+        uint8_t level = level_b;
+        *chips_b = ENCODE_SYMBOLS_CHIPS(data_b, 0, 32, &level);
+        level = level_a;
+        return ENCODE_SYMBOLS_CHIPS(data_a, 0, 32, &level);
+    #endif
+}
+
+/**
+  * @brief  Encode a group of frames in parallel lanes (multi-buffer): on
+  * each step 4 bytes of every frame are encoded, two frames for each
+  * ENCODE_PAIR_CHIPS() call, and each lane keeps its own position and
+  * signal level (lanes of frames that already ended encode nothing).
+  * @param  frames Pointer to the frames (up to BATCH_LANES).
+  * @param  num_frames Number of frames.
+  */
+static void ENCODE_BATCH_LANES(cdp_batch_frame_t* frames,
+        const uint8_t num_frames)
+{
+    uint32_t data[BATCH_LANES];
+    uint64_t chips[BATCH_LANES];
+    uint8_t len[BATCH_LANES];
+    size_t max_len = 0;
+
+    for(uint8_t n = 0; n < num_frames; n++)
+    {
+        if(frames[n].data_in_len > max_len)
+            max_len = frames[n].data_in_len;
+    }
+
+    for(size_t i = 0; i < max_len; i = i + 4)
+    {
+        // Gather 4 bytes of each frame
+        for(uint8_t n = 0; n < BATCH_LANES; n++)
+        {
+            len[n] = 0;
+            data[n] = 0;
+            if((n < num_frames) && (i < frames[n].data_in_len))
+            {
+                len[n] = (frames[n].data_in_len - i < 4) ?
+                        (uint8_t)(frames[n].data_in_len - i) : 4;
+                data[n] = (uint32_t)load_le64_len(frames[n].data_in + i,
+                        len[n]);
+            }
+        }
+
+        // Encode them
+        for(uint8_t n = 0; n < BATCH_LANES; n = n + 2)
+        {
+            chips[n] = ENCODE_PAIR_CHIPS(data[n], data[n + 1],
+                    (n < num_frames) ? frames[n].level : 0,
+                    (n + 1 < num_frames) ? frames[n + 1].level : 0,
+                    &(chips[n + 1]));
+        }
+
+        // Scatter the chips and keep the level after the last bit
+        for(uint8_t n = 0; n < num_frames; n++)
+        {
+            if(len[n] == 0)
+                continue;
+            store_le64_len(frames[n].data_out + 2*i, chips[n], len[n]*2);
+            frames[n].level = (uint8_t)((chips[n] >> (16*len[n] - 1)) &
+                    0x01);
+        }
+    }
+}
+
+/**
+  * @brief  Get the signal level after a number of data bytes of an encoded
+  * stream (its last chip, that has the level after the last bit).
+  * @param  chips Pointer to encoded stream (from INITIAL_SIGNAL_LEVEL).
+  * @param  num_bytes Number of data bytes (encoded bytes / 2).
+  * @return Signal level (LOW or HIGH).
+  */
+static inline uint8_t ENCODED_LEVEL(const uint8_t* chips,
+        const size_t num_bytes)
+{
+    if(num_bytes == 0)
+        return INITIAL_SIGNAL_LEVEL;
+    return ((chips[2*num_bytes - 1] >> 7) & 0x01);
+}
+
+/* Expand encode kernels for each samples per chip value (1 to 16) */
+typedef void (*encode_expand_kernel)(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out, const bool msb_first);
+static const encode_expand_kernel ENCODE_EXPAND_KERNELS[16] =
+{
+    ENCODE_EXPAND<1>,  ENCODE_EXPAND<2>,  ENCODE_EXPAND<3>,  ENCODE_EXPAND<4>,
+    ENCODE_EXPAND<5>,  ENCODE_EXPAND<6>,  ENCODE_EXPAND<7>,  ENCODE_EXPAND<8>,
+    ENCODE_EXPAND<9>,  ENCODE_EXPAND<10>, ENCODE_EXPAND<11>, ENCODE_EXPAND<12>,
+    ENCODE_EXPAND<13>, ENCODE_EXPAND<14>, ENCODE_EXPAND<15>, ENCODE_EXPAND<16>
+};
+
 /*****************************************************************************/
 
 /* Constructor & Destructor */
@@ -123,6 +583,73 @@ bool CDP::encode(const uint8_t* data_in, const size_t data_in_len,
     return true;
 }
 
+/**
+  * @brief  Encode input data continuing from a given signal level, so a
+  * stream can be encoded in consecutive pieces (or from a known level).
+  * Output is the same as encode() when the level starts at
+  * INITIAL_SIGNAL_LEVEL. All bits of each byte are encoded at once.
+  * @param  data_in Pointer to input data to be encode.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    uint16_t chips = 0x0000;
+
+    // Check if number of bytes to be encoded doesn't fit in output array
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i++)
+    {
+        chips = ENCODE_BYTE_CHIPS(data_in[i], current_signal_level);
+        data_out[2*i] = (uint8_t)(chips & 0x00ff);
+        data_out[2*i+1] = (uint8_t)((chips >> 8) & 0x00ff);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Encode input data replicating each chip samples_per_chip times,
+  * to drive the line with a SPI or I2S peripheral (each chip sent as K
+  * identical bits). The result can be written directly to the DMA transmit
+  * buffer, avoiding a second expansion pass over the encoded data.
+  * There is a kernel specialized at compile time for each K value.
+  * @param  data_in Pointer to input data to be encode.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the expanded
+  * encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len*2*samples_per_chip needed).
+  * @param  samples_per_chip Times each chip is replicated (1 to 16).
+  * @param  msb_first Output bits order in each byte (true for MSb bit sent
+  * first as usual on SPI; false for LSb bit first, as encode() output).
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode_oversampled(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        const uint8_t samples_per_chip, const bool msb_first)
+{
+    // Check samples per chip and if expanded data doesn't fit in output
+    if((samples_per_chip < 1) || (samples_per_chip > 16))
+        return false;
+    if(data_in_len*2*samples_per_chip > data_out_len)
+        return false;
+
+    ENCODE_EXPAND_KERNELS[samples_per_chip - 1](data_in, data_in_len,
+            data_out, msb_first);
+
+    return true;
+}
+
 /**
   * @brief  Encode byte value with Conditional DePhase (aka
   * Differential Manchester) code.
@@ -239,6 +766,222 @@ bool CDP::decode(const uint8_t* data_in, const size_t data_in_len,
     return true;
 }
 
+/**
+  * @brief  Decode input data continuing from a given signal level, so a
+  * stream can be decoded in consecutive pieces (or from a known level).
+  * Output is the same as decode() when the level starts at
+  * INITIAL_SIGNAL_LEVEL. All bits of each byte are decoded at once.
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode from input data (even).
+  * @param  data_out Pointer to output data array to store the decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    uint16_t chips = 0x0000;
+
+    // Check if number of bytes to be decoded doesn't fit in output array
+    if((data_out_len*2 < data_in_len) || (data_in_len % 2 != 0))
+        return false;
+
+    for(size_t i = 0; i < data_in_len/2; i++)
+    {
+        chips = (uint16_t)(data_in[2*i] | (data_in[2*i+1] << 8));
+        data_out[i] = DECODE_BYTE_CHIPS(chips, current_signal_level);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Decode input data continuing from a given signal level, and
+  * update a CRC register with the decoded data in the same pass (each 8
+  * bytes are given to the CRC while still in a register, instead of
+  * running the CRC over the output array afterwards). The decoded data
+  * CRC or FCS check result can be got from the CRC object.
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode from input data (even).
+  * @param  data_out Pointer to output data array to store the decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  crc Pointer to the CRC to update (NULL for none).
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, CDPCrc* crc)
+{
+    const size_t num_bytes = data_in_len / 2;
+    uint64_t data = 0;
+    size_t i = 0;
+
+    if(crc == NULL)
+    {
+        return this->decode(data_in, data_in_len, data_out, data_out_len,
+                current_signal_level);
+    }
+
+    // Check if number of bytes to be decoded doesn't fit in output array
+    if((data_out_len*2 < data_in_len) || (data_in_len % 2 != 0))
+        return false;
+
+    for(; i + 8 <= num_bytes; i = i + 8)
+    {
+        data = DECODE_WORD_CHIPS(load_le64(data_in + 2*i),
+                current_signal_level);
+        data = data | ((uint64_t)DECODE_WORD_CHIPS(load_le64(
+                data_in + 2*i + 8), current_signal_level) << 32);
+        crc->update_word(data, 8);
+        store_le64(data_out + i, data);
+    }
+
+    // Last bytes
+    if(i < num_bytes)
+    {
+        data = 0;
+        for(size_t n = 0; i + n < num_bytes; n++)
+        {
+            uint16_t chips = (uint16_t)(data_in[2*(i + n)] |
+                    (data_in[2*(i + n) + 1] << 8));
+            data = data | ((uint64_t)DECODE_BYTE_CHIPS(chips,
+                    current_signal_level) << (8*n));
+        }
+        crc->update_word(data, (uint8_t)(num_bytes - i));
+        store_le64_len(data_out + i, data, (uint8_t)(num_bytes - i));
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Encode a batch of frames (i.e. many tiny control frames) in
+  * parallel lanes, one frame for each lane as multi-buffer hashing does,
+  * so the SIMD kernel is used even when the frames are a few bytes long,
+  * and there is no call for each frame. The output of each frame is the
+  * same as encode() from the frame start signal level.
+  * @param  frames Pointer to the frames (the level of each frame is
+  * updated to the signal level at its end).
+  * @param  num_frames Number of frames.
+  * @return Encode result ok (true/false if some frame output doesn't fit,
+  * and then no frame is encoded).
+  */
+bool CDP::encode_batch(cdp_batch_frame_t* frames, const size_t num_frames)
+{
+    for(size_t i = 0; i < num_frames; i++)
+    {
+        if(frames[i].data_in_len*2 > frames[i].data_out_len)
+            return false;
+    }
+
+    for(size_t i = 0; i < num_frames; i = i + BATCH_LANES)
+    {
+        uint8_t n = (num_frames - i < BATCH_LANES) ?
+                (uint8_t)(num_frames - i) : BATCH_LANES;
+        ENCODE_BATCH_LANES(frames + i, n);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Encode data bits mixed with IEEE 802.5 J and K non-data symbols
+  * (code violations used by the starting and ending delimiters). Each data
+  * bit with its J/K flag set is encoded as J (bit 0) or K (bit 1) symbol.
+  * i.e. Starting delimiter JK0JK000: data 0x12, jk 0x1B.
+  * 32 symbols are encoded at once.
+  * @param  data_in Pointer to input data to be encode.
+  * @param  jk_in Pointer to input J/K flags bitmap (same size and bit order
+  * as input data).
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode_symbols(const uint8_t* data_in, const uint8_t* jk_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    size_t i = 0;
+
+    // Check if number of bytes to be encoded doesn't fit in output array
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    for(; i + 4 <= data_in_len; i = i + 4)
+    {
+        uint32_t data = (uint32_t)load_le64_len(data_in + i, 4);
+        uint32_t jk = (uint32_t)load_le64_len(jk_in + i, 4);
+        store_le64(data_out + 2*i, ENCODE_SYMBOLS_CHIPS(data, jk, 32,
+                current_signal_level));
+    }
+    for(; i < data_in_len; i++)
+    {
+        uint16_t chips = (uint16_t)ENCODE_SYMBOLS_CHIPS(data_in[i], jk_in[i],
+                8, current_signal_level);
+        data_out[2*i] = (uint8_t)(chips & 0x00ff);
+        data_out[2*i+1] = (uint8_t)((chips >> 8) & 0x00ff);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Decode data bits and IEEE 802.5 J and K non-data symbols. J/K
+  * symbol positions are reported in a side bitmap (data bit is 0 for J and
+  * 1 for K), while data bits decode as decode() does. 32 symbols are
+  * decoded at once.
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode from input data (even).
+  * @param  data_out Pointer to output data array to store the decoded data.
+  * @param  jk_out Pointer to output J/K flags bitmap (same size and bit
+  * order as output data).
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode_symbols(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, uint8_t* jk_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    size_t i = 0;
+    uint32_t jk = 0;
+    uint32_t data = 0;
+
+    // Check if number of bytes to be decoded doesn't fit in output array
+    if((data_out_len*2 < data_in_len) || (data_in_len % 2 != 0))
+        return false;
+
+    for(; i + 4 <= data_in_len/2; i = i + 4)
+    {
+        data = DECODE_SYMBOLS_CHIPS(load_le64(data_in + 2*i), 32, &jk,
+                current_signal_level);
+        store_le64_len(data_out + i, data, 4);
+        store_le64_len(jk_out + i, jk, 4);
+    }
+    for(; i < data_in_len/2; i++)
+    {
+        uint16_t chips = (uint16_t)(data_in[2*i] | (data_in[2*i+1] << 8));
+        data_out[i] = (uint8_t)DECODE_SYMBOLS_CHIPS(chips, 8, &jk,
+                current_signal_level);
+        jk_out[i] = (uint8_t)jk;
+    }
+
+    return true;
+}
+
 /**
   * @brief  Decode byte value with Conditional DePhase (aka
   * Differential Manchester) code.
@@ -320,3 +1063,238 @@ uint8_t CDP::decode_bit(const uint8_t data_bit, uint8_t* current_signal_level)
         return bit_value;
     }
 }
+
+/*****************************************************************************/
+
+/* Encoded Data Methods */
+
+/**
+  * @brief  Join two encoded streams (each one encoded from
+  * INITIAL_SIGNAL_LEVEL) into a single encoded stream, without decoding
+  * them. The level at the seam is the last chip of the first stream, and
+  * if it is not INITIAL_SIGNAL_LEVEL the second stream is inverted.
+  * @param  data_in_a Pointer to first encoded stream.
+  * @param  data_in_a_len Number of bytes of first encoded stream (even).
+  * @param  data_in_b Pointer to second encoded stream.
+  * @param  data_in_b_len Number of bytes of second encoded stream (even).
+  * @param  data_out Pointer to output data array to store the joined
+  * stream (it can be data_in_a, to append the second stream in place).
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @return Concat result ok (true/false).
+  */
+bool CDP::concat(const uint8_t* data_in_a, const size_t data_in_a_len,
+        const uint8_t* data_in_b, const size_t data_in_b_len,
+        uint8_t* data_out, const size_t data_out_len)
+{
+    // Check encoded streams lengths and if they don't fit in output array
+    if((data_in_a_len % 2 != 0) || (data_in_b_len % 2 != 0) ||
+       (data_in_a_len + data_in_b_len > data_out_len))
+        return false;
+
+    if(data_out != data_in_a)
+        memcpy(data_out, data_in_a, data_in_a_len);
+    if(ENCODED_LEVEL(data_in_a, data_in_a_len/2) == INITIAL_SIGNAL_LEVEL)
+        memcpy(data_out + data_in_a_len, data_in_b, data_in_b_len);
+    else
+        copy_not(data_out + data_in_a_len, data_in_b, data_in_b_len);
+
+    return true;
+}
+
+/**
+  * @brief  Cut a range of an encoded stream (encoded from
+  * INITIAL_SIGNAL_LEVEL) as a standalone encoded stream, without decoding
+  * it. The level before the range is the chip before it, and if it is not
+  * INITIAL_SIGNAL_LEVEL the range is inverted.
+  * @param  data_in Pointer to encoded stream.
+  * @param  data_in_len Number of bytes of encoded stream.
+  * @param  position Encoded byte position of the range (even).
+  * @param  len Number of encoded bytes of the range (even).
+  * @param  data_out Pointer to output data array to store the range.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @return Slice result ok (true/false).
+  */
+bool CDP::slice(const uint8_t* data_in, const size_t data_in_len,
+        const size_t position, const size_t len, uint8_t* data_out,
+        const size_t data_out_len)
+{
+    // Check range alignment and limits, and if it doesn't fit in output
+    if((position % 2 != 0) || (len % 2 != 0) || (position > data_in_len) ||
+       (len > data_in_len - position) || (len > data_out_len))
+        return false;
+
+    if(ENCODED_LEVEL(data_in, position/2) == INITIAL_SIGNAL_LEVEL)
+        memcpy(data_out, data_in + position, len);
+    else
+        copy_not(data_out, data_in + position, len);
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Typed Data Methods */
+
+/**
+  * @brief  Encode an array of 16 bits values in network byte order (most
+  * significant byte first), continuing from a given signal level. The
+  * byte swap is done in the encode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to input values to be encoded.
+  * @param  data_in_len Number of values to encode.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (4 bytes for each value).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first Send the bits of each byte MSb first (so each value
+  * goes fully MSb first) instead of LSb first.
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode_be(const uint16_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    if(data_in_len*sizeof(uint16_t)*2 > data_out_len)
+        return false;
+    ENCODE_BE(data_in, data_in_len, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
+
+/**
+  * @brief  Encode an array of 32 bits values in network byte order (most
+  * significant byte first), continuing from a given signal level. The
+  * byte swap is done in the encode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to input values to be encoded.
+  * @param  data_in_len Number of values to encode.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (8 bytes for each value).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first Send the bits of each byte MSb first (so each value
+  * goes fully MSb first) instead of LSb first.
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode_be(const uint32_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    if(data_in_len*sizeof(uint32_t)*2 > data_out_len)
+        return false;
+    ENCODE_BE(data_in, data_in_len, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
+
+/**
+  * @brief  Encode an array of 64 bits values in network byte order (most
+  * significant byte first), continuing from a given signal level. The
+  * byte swap is done in the encode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to input values to be encoded.
+  * @param  data_in_len Number of values to encode.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (16 bytes for each value).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first Send the bits of each byte MSb first (so each value
+  * goes fully MSb first) instead of LSb first.
+  * @return Encode result ok (true/false).
+  */
+bool CDP::encode_be(const uint64_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    if(data_in_len*sizeof(uint64_t)*2 > data_out_len)
+        return false;
+    ENCODE_BE(data_in, data_in_len, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
+
+/**
+  * @brief  Decode an array of 16 bits values sent in network byte order
+  * (as encode_be() output), continuing from a given signal level. The byte
+  * swap is done in the decode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode (4 bytes for each value).
+  * @param  data_out Pointer to output array to store the decoded values.
+  * @param  data_out_len Number of values that can be stored in the output
+  * array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first The bits of each byte were sent MSb first.
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode_be(const uint8_t* data_in, const size_t data_in_len,
+        uint16_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    const size_t num_values = data_in_len / (sizeof(uint16_t)*2);
+
+    if((data_in_len % (sizeof(uint16_t)*2) != 0) ||
+       (num_values > data_out_len))
+        return false;
+    DECODE_BE(data_in, num_values, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
+
+/**
+  * @brief  Decode an array of 32 bits values sent in network byte order
+  * (as encode_be() output), continuing from a given signal level. The byte
+  * swap is done in the decode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode (8 bytes for each value).
+  * @param  data_out Pointer to output array to store the decoded values.
+  * @param  data_out_len Number of values that can be stored in the output
+  * array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first The bits of each byte were sent MSb first.
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode_be(const uint8_t* data_in, const size_t data_in_len,
+        uint32_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    const size_t num_values = data_in_len / (sizeof(uint32_t)*2);
+
+    if((data_in_len % (sizeof(uint32_t)*2) != 0) ||
+       (num_values > data_out_len))
+        return false;
+    DECODE_BE(data_in, num_values, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
+
+/**
+  * @brief  Decode an array of 64 bits values sent in network byte order
+  * (as encode_be() output), continuing from a given signal level. The byte
+  * swap is done in the decode kernel (no swapped copy is needed).
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode (16 bytes for each value).
+  * @param  data_out Pointer to output array to store the decoded values.
+  * @param  data_out_len Number of values that can be stored in the output
+  * array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @param  msb_first The bits of each byte were sent MSb first.
+  * @return Decode result ok (true/false).
+  */
+bool CDP::decode_be(const uint8_t* data_in, const size_t data_in_len,
+        uint64_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level, const bool msb_first)
+{
+    const size_t num_values = data_in_len / (sizeof(uint64_t)*2);
+
+    if((data_in_len % (sizeof(uint64_t)*2) != 0) ||
+       (num_values > data_out_len))
+        return false;
+    DECODE_BE(data_in, num_values, data_out, msb_first,
+            current_signal_level);
+    return true;
+}
@@ -44,6 +44,35 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "cdp_crc.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+#define LOGIC_LEVEL_LOW  0
+#define LOGIC_LEVEL_HIGH 1
+#define INITIAL_SIGNAL_LEVEL LOGIC_LEVEL_HIGH
+
+// IEEE 802.5 J/K non-data symbols data bit values (symbols are marked in a
+// J/K flags bitmap besides the data)
+#define SYMBOL_J_BIT 0
+#define SYMBOL_K_BIT 1
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Frame of a batch encode */
+typedef struct
+{
+    const uint8_t* data_in;     // Data to encode
+    size_t data_in_len;         // Number of bytes of data
+    uint8_t* data_out;          // Output array for the encoded data
+    size_t data_out_len;        // Number of bytes of the output array
+    uint8_t level;              // Signal level at start (updated to the end)
+} cdp_batch_frame_t;
+
 /*****************************************************************************/
 
 /* Class Interface */
@@ -60,6 +89,60 @@ class CDP
         bool decode(const uint8_t* data_in, const size_t data_in_len,
                 uint8_t* data_out, const size_t data_out_len);
 
+        bool encode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool decode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool decode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, CDPCrc* crc);
+
+        bool encode_batch(cdp_batch_frame_t* frames,
+                const size_t num_frames);
+
+        bool encode_symbols(const uint8_t* data_in, const uint8_t* jk_in,
+                const size_t data_in_len, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+        bool decode_symbols(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, uint8_t* jk_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+
+        bool encode_oversampled(const uint8_t* data_in,
+                const size_t data_in_len, uint8_t* data_out,
+                const size_t data_out_len, const uint8_t samples_per_chip,
+                const bool msb_first);
+
+        bool concat(const uint8_t* data_in_a, const size_t data_in_a_len,
+                const uint8_t* data_in_b, const size_t data_in_b_len,
+                uint8_t* data_out, const size_t data_out_len);
+        bool slice(const uint8_t* data_in, const size_t data_in_len,
+                const size_t position, const size_t len, uint8_t* data_out,
+                const size_t data_out_len);
+
+        // Values in network byte order: encode_be() data_in_len counts
+        // values and data_out_len bytes, decode_be() data_in_len counts
+        // encoded bytes and data_out_len values
+        bool encode_be(const uint16_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+        bool encode_be(const uint32_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+        bool encode_be(const uint64_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+        bool decode_be(const uint8_t* data_in, const size_t data_in_len,
+                uint16_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+        bool decode_be(const uint8_t* data_in, const size_t data_in_len,
+                uint32_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+        bool decode_be(const uint8_t* data_in, const size_t data_in_len,
+                uint64_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level, const bool msb_first);
+
     private:
 
         uint16_t encode_byte(const uint8_t data_byte,
@@ -0,0 +1,255 @@
+/**
+ * @file    cdp_aes3.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * AES3 / S/PDIF subframes engine.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_aes3.h"
+#include "cdp_linecode.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Preambles chips (LSB-first) for LOW level before them (X: 11100010,
+// Y: 11100100, Z: 11101000 in time order), inverted for HIGH level
+static const uint8_t PREAMBLE_CHIPS[3] = { 0x47, 0x27, 0x17 };
+
+// Chips of the preamble (time slots 0 to 3)
+#define PREAMBLE_CHIPS_LEN 8
+
+// Bits after the preamble (audio sample, V, U, C and P bits)
+#define SUBFRAME_DATA_BITS 28
+
+// Bits of audio sample (time slots 4 to 27)
+#define SAMPLE_BITS 24
+#define SAMPLE_MASK 0x00FFFFFF
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPAES3 constructor */
+CDPAES3::CDPAES3()
+{
+    this->encoder_setup(NULL, NULL, true);
+}
+
+/* CDPAES3 destructor */
+CDPAES3::~CDPAES3()
+{}
+
+/*****************************************************************************/
+
+/* Encode Methods */
+
+/**
+  * @brief  Setup the encoder for a new stream (starting with a new block).
+  * @param  channel_status Pointer to the channel status block (24 bytes,
+  * the same for both channels; NULL for all zeros).
+  * @param  user_data Pointer to the user data block (24 bytes, a U bit for
+  * each frame LSb first, the same for both channels; NULL for all zeros).
+  * @param  valid Audio samples are valid (validity bit clear).
+  */
+void CDPAES3::encoder_setup(const uint8_t* channel_status,
+        const uint8_t* user_data, const bool valid)
+{
+    if(channel_status != NULL)
+        memcpy(this->channel_status, channel_status, AES3_CHANNEL_STATUS_LEN);
+    else
+        memset(this->channel_status, 0, AES3_CHANNEL_STATUS_LEN);
+    if(user_data != NULL)
+        memcpy(this->user_data, user_data, AES3_USER_DATA_LEN);
+    else
+        memset(this->user_data, 0, AES3_USER_DATA_LEN);
+    this->valid = valid;
+    this->frame_n = 0;
+    this->current_signal_level = LOGIC_LEVEL_LOW;
+}
+
+/**
+  * @brief  Encode audio frames into subframes chips (AES3_SUBFRAME_LEN
+  * bytes each, LSB-first chips as encode() output). The 28 bits after the
+  * preamble of a subframe are encoded at once with the biphase mark
+  * kernel, and the parity bit keeps the signal level of each subframe, so
+  * the preambles are always the same chips.
+  * @param  samples Pointer to audio samples (24 bits, channels A and B
+  * interleaved).
+  * @param  num_frames Number of frames (pairs of samples) to encode.
+  * @param  data_out Pointer to output data array to store the chips.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (num_frames*16 needed).
+  * @return Encode result ok (true/false).
+  */
+bool CDPAES3::encode(const int32_t* samples, const size_t num_frames,
+        uint8_t* data_out, const size_t data_out_len)
+{
+    if(num_frames*AES3_FRAME_SUBFRAMES*AES3_SUBFRAME_LEN > data_out_len)
+        return false;
+
+    for(size_t i = 0; i < num_frames*AES3_FRAME_SUBFRAMES; i++)
+    {
+        uint8_t preamble = (i % 2) ? AES3_PREAMBLE_Y : AES3_PREAMBLE_X;
+        uint8_t c_bit = (this->channel_status[this->frame_n / 8] >>
+                (this->frame_n % 8)) & 0x01;
+        uint8_t u_bit = (this->user_data[this->frame_n / 8] >>
+                (this->frame_n % 8)) & 0x01;
+        uint32_t bits = ((uint32_t)samples[i] & SAMPLE_MASK);
+        uint64_t chips = PREAMBLE_CHIPS[preamble];
+
+        if((preamble == AES3_PREAMBLE_X) && (this->frame_n == 0))
+            chips = PREAMBLE_CHIPS[AES3_PREAMBLE_Z];
+        if(this->current_signal_level)
+            chips = ~chips & 0xFF;
+
+        // Sample, V, U, C and P bits (biphase mark after the preamble)
+        if(this->valid == false)
+            bits = bits | ((uint32_t)AES3_V_BIT << SAMPLE_BITS);
+        bits = bits | ((uint32_t)u_bit << (SAMPLE_BITS + 1));
+        bits = bits | ((uint32_t)c_bit << (SAMPLE_BITS + 2));
+        bits = bits | ((uint32_t)parity64(bits) << (SAMPLE_BITS + 3));
+        chips = chips | (CDPBiphaseMark::ENCODE_BITS(bits,
+                SUBFRAME_DATA_BITS, &(this->current_signal_level)) <<
+                PREAMBLE_CHIPS_LEN);
+        store_le64(data_out + i*AES3_SUBFRAME_LEN, chips);
+
+        if(i % 2)
+            this->frame_n = (this->frame_n + 1) % AES3_BLOCK_FRAMES;
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Decode subframes from a chip stream. A preamble is looked for at
+  * each chip position until one is found (biphase mark data never has the
+  * three equal chips of a preamble) with another one 64 chips after it,
+  * and then the next subframes are expected each 64 chips (a new preamble
+  * is looked for if one is missing). The 28 bits after each preamble are
+  * decoded at once (a data bit is 1 if its two chips differ).
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips of the stream.
+  * @param  start_chip Chip position to start looking from.
+  * @param  subframes Pointer to array to store decoded subframes.
+  * @param  subframes_len Number of elements of the subframes array.
+  * @return Number of subframes decoded (decode can continue from the chip
+  * after the last subframe).
+  */
+size_t CDPAES3::decode(const uint8_t* chips, const uint64_t num_chips,
+        const uint64_t start_chip, cdp_aes3_subframe_t* subframes,
+        const size_t subframes_len)
+{
+    uint64_t chip_n = start_chip;
+    size_t num_subframes = 0;
+    bool sync = false;
+
+    while((chip_n + AES3_SUBFRAME_CHIPS <= num_chips) &&
+          (num_subframes < subframes_len))
+    {
+        uint64_t word = load_chips64(chips, num_chips, chip_n);
+        cdp_aes3_subframe_t* subframe = &(subframes[num_subframes]);
+        uint32_t bits = 0;
+        uint8_t next_preamble = 0;
+
+        if(this->find_preamble(word, &(subframe->preamble)) == false)
+        {
+            sync = false;
+            chip_n = chip_n + 1;
+            continue;
+        }
+
+        // Without sync, an idle line before a preamble can look like
+        // another preamble: check the transition at its start and the
+        // next preamble
+        if(sync == false)
+        {
+            uint64_t next_chip = chip_n + AES3_SUBFRAME_CHIPS;
+            if(((chip_n > 0) && (((load_chips64(chips, num_chips,
+                    chip_n - 1) ^ word) & 0x01) == 0)) ||
+               ((next_chip + AES3_SUBFRAME_CHIPS <= num_chips) &&
+               (this->find_preamble(load_chips64(chips, num_chips,
+                    next_chip), &next_preamble) == false)))
+            {
+                chip_n = chip_n + 1;
+                continue;
+            }
+            sync = true;
+        }
+
+        word = word >> PREAMBLE_CHIPS_LEN;
+        bits = (compress_even64(word) ^ compress_even64(word >> 1)) &
+                ((1UL << SUBFRAME_DATA_BITS) - 1);
+        subframe->chip = chip_n;
+        subframe->sample = (int32_t)((bits & SAMPLE_MASK) << 8) >> 8;
+        subframe->vucp = (uint8_t)(bits >> SAMPLE_BITS);
+        subframe->parity_ok = (parity64(bits) == 0);
+        num_subframes = num_subframes + 1;
+        chip_n = chip_n + AES3_SUBFRAME_CHIPS;
+    }
+
+    return num_subframes;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Check if a chips word starts with a preamble (any signal level
+  * before it).
+  * @param  chips Chips word.
+  * @param  preamble Pointer to store the preamble found.
+  * @return Preamble found (true/false).
+  */
+bool CDPAES3::find_preamble(const uint64_t chips, uint8_t* preamble)
+{
+    uint8_t first_chips = (uint8_t)chips;
+
+    // Preambles after HIGH level (first chip LOW) are inverted
+    if((first_chips & 0x01) == 0)
+        first_chips = (uint8_t)~first_chips;
+    for(uint8_t i = AES3_PREAMBLE_X; i <= AES3_PREAMBLE_Z; i++)
+    {
+        if(first_chips == PREAMBLE_CHIPS[i])
+        {
+            *preamble = i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file    cdp_aes3.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * AES3 / S/PDIF subframes engine: packs 24 bits audio samples into
+ * subframes (validity, user, channel status and parity bits), encodes
+ * them with biphase mark code and X/Y/Z preambles (code violations, as
+ * 802.5 J/K symbols), and decodes chip streams back with preambles
+ * detection at any chip position.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_AES3_H_
+#define CDP_AES3_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Chips and encoded bytes of each subframe (32 time slots, 2 chips each)
+#define AES3_SUBFRAME_CHIPS 64
+#define AES3_SUBFRAME_LEN   8
+
+// Subframes of each frame (channels A and B)
+#define AES3_FRAME_SUBFRAMES 2
+
+// Frames of each block, and channel status and user data bytes (a bit for
+// each frame)
+#define AES3_BLOCK_FRAMES 192
+#define AES3_CHANNEL_STATUS_LEN 24
+#define AES3_USER_DATA_LEN 24
+
+// Preambles (X: channel A, Y: channel B, Z: channel A at block start)
+#define AES3_PREAMBLE_X 0
+#define AES3_PREAMBLE_Y 1
+#define AES3_PREAMBLE_Z 2
+
+// Subframe validity, user data, channel status and parity bits
+#define AES3_V_BIT 0x01
+#define AES3_U_BIT 0x02
+#define AES3_C_BIT 0x04
+#define AES3_P_BIT 0x08
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Decoded subframe */
+typedef struct
+{
+    uint64_t chip;      // Position of the first chip of the subframe
+    int32_t sample;     // Audio sample (24 bits, sign extended)
+    uint8_t preamble;   // AES3_PREAMBLE_X, AES3_PREAMBLE_Y or Z
+    uint8_t vucp;       // V, U, C and P bits
+    bool parity_ok;     // Even parity of time slots 4 to 31 ok
+} cdp_aes3_subframe_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPAES3
+{
+    public:
+
+        CDPAES3();
+        ~CDPAES3();
+
+        void encoder_setup(const uint8_t* channel_status,
+                const uint8_t* user_data, const bool valid);
+        bool encode(const int32_t* samples, const size_t num_frames,
+                uint8_t* data_out, const size_t data_out_len);
+
+        size_t decode(const uint8_t* chips, const uint64_t num_chips,
+                const uint64_t start_chip, cdp_aes3_subframe_t* subframes,
+                const size_t subframes_len);
+
+    private:
+
+        uint8_t channel_status[AES3_CHANNEL_STATUS_LEN];
+        uint8_t user_data[AES3_USER_DATA_LEN];
+        bool valid;
+        uint16_t frame_n;
+        uint8_t current_signal_level;
+
+        bool find_preamble(const uint64_t chips, uint8_t* preamble);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_AES3_H_ */
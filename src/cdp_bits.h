@@ -0,0 +1,440 @@
+/**
+ * @file    cdp_bits.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Internal word-parallel bit manipulation helpers shared by the CDP
+ * library modules. Chip streams are handled as LSB-first bitstreams (chip
+ * k is bit k%8 of byte k/8), which is the layout that CDP::encode()
+ * produces, so 64 chips can be loaded as one little-endian 64 bits word.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_BITS_H_
+#define CDP_BITS_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+/*****************************************************************************/
+
+/* Constants */
+
+#define EVEN_BITS_MASK_64 0x5555555555555555ULL
+#define ODD_BITS_MASK_64  0xAAAAAAAAAAAAAAAAULL
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Load 8 bytes as a little-endian 64 bits word.
+  * @param  data Pointer to the bytes to load.
+  * @return Loaded word.
+  */
+static inline uint64_t load_le64(const uint8_t* data)
+{
+    uint64_t word = 0;
+    for(uint8_t i = 0; i < 8; i++)
+        word = word | ((uint64_t)data[i] << (8*i));
+    return word;
+}
+
+/**
+  * @brief  Store a 64 bits word as 8 little-endian bytes.
+  * @param  data Pointer to the bytes destination.
+  * @param  word Word to store.
+  */
+static inline void store_le64(uint8_t* data, const uint64_t word)
+{
+    for(uint8_t i = 0; i < 8; i++)
+        data[i] = (uint8_t)(word >> (8*i));
+}
+
+/**
+  * @brief  Load up to 8 bytes as a little-endian word.
+  * @param  data Pointer to the bytes to load.
+  * @param  len Number of bytes to load (0 to 8).
+  * @return Loaded word.
+  */
+static inline uint64_t load_le64_len(const uint8_t* data, const uint8_t len)
+{
+    uint64_t word = 0;
+    for(uint8_t i = 0; i < len; i++)
+        word = word | ((uint64_t)data[i] << (8*i));
+    return word;
+}
+
+/**
+  * @brief  Store the low bytes of a word as little-endian bytes.
+  * @param  data Pointer to the bytes destination.
+  * @param  word Word to store.
+  * @param  len Number of bytes to store (0 to 8).
+  */
+static inline void store_le64_len(uint8_t* data, const uint64_t word,
+        const uint8_t len)
+{
+    for(uint8_t i = 0; i < len; i++)
+        data[i] = (uint8_t)(word >> (8*i));
+}
+
+/**
+  * @brief  Load 64 chips from any chip position of a packed chip stream,
+  * with zeros past its end.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips of the stream.
+  * @param  chip_n Chip position to load from.
+  * @return Loaded chips.
+  */
+static inline uint64_t load_chips64(const uint8_t* chips,
+        const uint64_t num_chips, const uint64_t chip_n)
+{
+    const uint64_t num_bytes = (num_chips + 7) / 8;
+    const uint64_t byte_n = chip_n / 8;
+    const uint8_t shift = chip_n % 8;
+    uint64_t word = 0;
+    uint64_t next = 0;
+
+    if(byte_n + 8 <= num_bytes)
+        word = load_le64(chips + byte_n);
+    else if(byte_n < num_bytes)
+        word = load_le64_len(chips + byte_n, (uint8_t)(num_bytes - byte_n));
+    if((shift != 0) && (byte_n + 8 < num_bytes))
+        next = chips[byte_n + 8];
+    if(shift != 0)
+        word = (word >> shift) | (next << (64 - shift));
+    return word;
+}
+
+/**
+  * @brief  Count trailing zero bits of a non-zero 64 bits word.
+  * @param  word Word to check (must be non-zero).
+  * @return Index of the least significant set bit.
+  */
+static inline uint8_t ctz64(const uint64_t word)
+{
+    #if defined(__GNUC__)
+        return (uint8_t)__builtin_ctzll(word);
+    #else
+        uint8_t n = 0;
+        while(((word >> n) & 0x01) == 0)
+            n = n + 1;
+        return n;
+    #endif
+}
+
+/**
+  * @brief  Get parity (xor of all bits) of a 64 bits word.
+  * @param  word Word to check.
+  * @return Parity bit (0 or 1).
+  */
+static inline uint8_t parity64(uint64_t word)
+{
+    #if defined(__GNUC__)
+        return (uint8_t)__builtin_parityll(word);
+    #else
+        word = word ^ (word >> 32);
+        word = word ^ (word >> 16);
+        word = word ^ (word >> 8);
+        word = word ^ (word >> 4);
+        word = word ^ (word >> 2);
+        word = word ^ (word >> 1);
+        return (uint8_t)(word & 0x01);
+    #endif
+}
+
+/**
+  * @brief  Gather the even bits (0, 2, 4...) of a 64 bits word into the
+  * 32 low bits of the result (bit 2*i goes to bit i).
+  * @param  word Word to compress.
+  * @return Compressed even bits.
+  */
+static inline uint32_t compress_even64(uint64_t word)
+{
+    #if defined(__BMI2__)
+        return (uint32_t)_pext_u64(word, EVEN_BITS_MASK_64);
+    #else
+        word = word & EVEN_BITS_MASK_64;
+        word = (word | (word >> 1)) & 0x3333333333333333ULL;
+        word = (word | (word >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+        word = (word | (word >> 4)) & 0x00FF00FF00FF00FFULL;
+        word = (word | (word >> 8)) & 0x0000FFFF0000FFFFULL;
+        word = (word | (word >> 16)) & 0x00000000FFFFFFFFULL;
+        return (uint32_t)word;
+    #endif
+}
+
+/**
+  * @brief  Spread the 32 bits of a word into the even bits of a 64 bits
+  * word (bit i goes to bit 2*i). Inverse of compress_even64().
+  * @param  word Word to expand.
+  * @return Expanded word.
+  */
+static inline uint64_t expand_even64(const uint32_t word)
+{
+    #if defined(__BMI2__)
+        return _pdep_u64(word, EVEN_BITS_MASK_64);
+    #else
+        uint64_t x = word;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x << 2)) & 0x3333333333333333ULL;
+        x = (x | (x << 1)) & EVEN_BITS_MASK_64;
+        return x;
+    #endif
+}
+
+/**
+  * @brief  Gather the least significant bit of each byte of a 64 bits word
+  * into one byte (bit 0 of byte i goes to bit i).
+  * @param  word Word to pack.
+  * @return Packed bits byte.
+  */
+static inline uint8_t pack_bytes_lsb64(const uint64_t word)
+{
+    #if defined(__BMI2__)
+        return (uint8_t)_pext_u64(word, 0x0101010101010101ULL);
+    #else
+        return (uint8_t)(((word & 0x0101010101010101ULL) *
+                0x0102040810204080ULL) >> 56);
+    #endif
+}
+
+/**
+  * @brief  Reverse the bits order of a byte.
+  * @param  data Byte to reverse.
+  * @return Reversed byte.
+  */
+static inline uint8_t reverse_bits8(uint8_t data)
+{
+    data = (uint8_t)(((data & 0xF0) >> 4) | ((data & 0x0F) << 4));
+    data = (uint8_t)(((data & 0xCC) >> 2) | ((data & 0x33) << 2));
+    data = (uint8_t)(((data & 0xAA) >> 1) | ((data & 0x55) << 1));
+    return data;
+}
+
+/**
+  * @brief  Reverse the bits order of each byte of a 64 bits word (8 bytes
+  * at once, as reverse_bits8()).
+  * @param  word Word to reverse.
+  * @return Word with the bits of each byte reversed.
+  */
+static inline uint64_t reverse_bits8x8(uint64_t word)
+{
+    word = ((word & 0xF0F0F0F0F0F0F0F0ULL) >> 4) |
+            ((word & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    word = ((word & 0xCCCCCCCCCCCCCCCCULL) >> 2) |
+            ((word & 0x3333333333333333ULL) << 2);
+    word = ((word & ODD_BITS_MASK_64) >> 1) |
+            ((word & EVEN_BITS_MASK_64) << 1);
+    return word;
+}
+
+/**
+  * @brief  Reverse the bytes order of a 64 bits word.
+  * @param  word Word to reverse.
+  * @return Word with its bytes in reverse order.
+  */
+static inline uint64_t bswap64(uint64_t word)
+{
+    #if defined(__GNUC__)
+        return __builtin_bswap64(word);
+    #else
+        word = ((word & 0xFF00FF00FF00FF00ULL) >> 8) |
+                ((word & 0x00FF00FF00FF00FFULL) << 8);
+        word = ((word & 0xFFFF0000FFFF0000ULL) >> 16) |
+                ((word & 0x0000FFFF0000FFFFULL) << 16);
+        return (word >> 32) | (word << 32);
+    #endif
+}
+
+/**
+  * @brief  Transpose a 8x8 bits matrix stored in a 64 bits word (byte r is
+  * row r, bit c of it is column c), swapping 2x2, 4x4 and 8x8 blocks.
+  * @param  word Matrix to transpose.
+  * @return Transposed matrix (bit c of byte r goes to bit r of byte c).
+  */
+static inline uint64_t transpose_bits8x8(uint64_t word)
+{
+    uint64_t t = (word ^ (word >> 7)) & 0x00AA00AA00AA00AAULL;
+    word = word ^ t ^ (t << 7);
+    t = (word ^ (word >> 14)) & 0x0000CCCC0000CCCCULL;
+    word = word ^ t ^ (t << 14);
+    t = (word ^ (word >> 28)) & 0x00000000F0F0F0F0ULL;
+    word = word ^ t ^ (t << 28);
+    return word;
+}
+
+/**
+  * @brief  Transpose a 8x8 bytes matrix stored in 8 words (word r is row r,
+  * byte c of it is column c), with the same blocks swap steps as
+  * transpose_bits8x8().
+  * @param  words Matrix to transpose (transposed in place).
+  */
+static inline void transpose_bytes8x8(uint64_t* words)
+{
+    uint64_t t;
+
+    for(uint8_t r = 0; r < 8; r = r + 2)
+    {
+        t = ((words[r] >> 8) ^ words[r + 1]) & 0x00FF00FF00FF00FFULL;
+        words[r + 1] = words[r + 1] ^ t;
+        words[r] = words[r] ^ (t << 8);
+    }
+    for(uint8_t r = 0; r < 6; r = (r == 1) ? 4 : (r + 1))
+    {
+        t = ((words[r] >> 16) ^ words[r + 2]) & 0x0000FFFF0000FFFFULL;
+        words[r + 2] = words[r + 2] ^ t;
+        words[r] = words[r] ^ (t << 16);
+    }
+    for(uint8_t r = 0; r < 4; r++)
+    {
+        t = ((words[r] >> 32) ^ words[r + 4]) & 0x00000000FFFFFFFFULL;
+        words[r + 4] = words[r + 4] ^ t;
+        words[r] = words[r] ^ (t << 32);
+    }
+}
+
+/**
+  * @brief  Prefix xor of a 32 bits word (bit i of result is the xor of
+  * bits 0 to i of the input word).
+  * @param  word Word to scan.
+  * @return Prefix xor word.
+  */
+static inline uint32_t prefix_xor32(uint32_t word)
+{
+    word = word ^ (word << 1);
+    word = word ^ (word << 2);
+    word = word ^ (word << 4);
+    word = word ^ (word << 8);
+    word = word ^ (word << 16);
+    return word;
+}
+
+/**
+  * @brief  Check if a block of bytes has all its bits equal to a level.
+  * It is used to skip idle line periods 16 bytes at once.
+  * @param  data Pointer to the block of bytes.
+  * @param  data_len Number of bytes of the block.
+  * @param  level Logic level to check (0 or 1).
+  * @return Number of leading bytes of the block that are idle.
+  */
+static inline size_t idle_bytes_len(const uint8_t* data, const size_t data_len,
+        const uint8_t level)
+{
+    const uint8_t idle_byte = level ? 0xFF : 0x00;
+    size_t i = 0;
+
+    #if defined(__SSE2__)
+        const __m128i idle_vector = _mm_set1_epi8((char)idle_byte);
+        while(i + 16 <= data_len)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(block, idle_vector)) != 0xFFFF)
+                break;
+            i = i + 16;
+        }
+    #endif
+    while(i < data_len && data[i] == idle_byte)
+        i = i + 1;
+
+    return i;
+}
+
+/**
+  * @brief  Copy a block of bytes inverting all its bits (16 bytes at once).
+  * An encoded block with the opposite starting level is the inverted block.
+  * @param  data_out Pointer to the destination bytes.
+  * @param  data_in Pointer to the source bytes.
+  * @param  data_len Number of bytes to copy.
+  */
+static inline void copy_not(uint8_t* data_out, const uint8_t* data_in,
+        const size_t data_len)
+{
+    size_t i = 0;
+
+    #if defined(__SSE2__)
+        const __m128i ones = _mm_set1_epi8((char)0xFF);
+        for(; i + 16 <= data_len; i += 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(data_in + i));
+            _mm_storeu_si128((__m128i*)(data_out + i),
+                    _mm_xor_si128(block, ones));
+        }
+    #endif
+    for(; i + 8 <= data_len; i += 8)
+        store_le64(data_out + i, ~load_le64(data_in + i));
+    for(; i < data_len; i++)
+        data_out[i] = (uint8_t)~data_in[i];
+}
+
+/**
+  * @brief  Hash a block of bytes 8 bytes at once (multiply and xorshift
+  * mixing of each word).
+  * @param  data Pointer to the bytes to hash.
+  * @param  data_len Number of bytes to hash.
+  * @param  seed Initial hash value (i.e. hash of a previous block).
+  * @return Hash value.
+  */
+static inline uint64_t hash64(const uint8_t* data, const size_t data_len,
+        uint64_t seed)
+{
+    const uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = seed ^ (data_len * MULTIPLIER);
+    size_t i = 0;
+
+    for(; i + 8 <= data_len; i += 8)
+    {
+        hash = (hash ^ load_le64(data + i)) * MULTIPLIER;
+        hash = hash ^ (hash >> 29);
+    }
+    if(i < data_len)
+    {
+        hash = (hash ^ load_le64_len(data + i, (uint8_t)(data_len - i))) *
+                MULTIPLIER;
+        hash = hash ^ (hash >> 29);
+    }
+
+    return hash ^ (hash >> 32);
+}
+
+/*****************************************************************************/
+
+#endif /* CDP_BITS_H_ */
@@ -0,0 +1,329 @@
+/**
+ * @file    cdp_cache.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Least recently used cache of encoded data.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_cache.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPEncodeCache constructor */
+CDPEncodeCache::CDPEncodeCache()
+{
+    this->reset();
+}
+
+/* CDPEncodeCache destructor */
+CDPEncodeCache::~CDPEncodeCache()
+{}
+
+/*****************************************************************************/
+
+/* Encode Methods */
+
+/**
+  * @brief  Encode input data through the cache (same result as
+  * CDP::encode() with signal level).
+  * @param  data_in Pointer to input data to be encode.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Encode result ok (true/false).
+  */
+bool CDPEncodeCache::encode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    // Check if number of bytes to be encoded doesn't fit in output array
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    return this->encode_cached(data_in, NULL, data_in_len, data_out,
+            current_signal_level);
+}
+
+/**
+  * @brief  Encode input data with J/K symbols through the cache (same
+  * result as CDP::encode_symbols()).
+  * @param  data_in Pointer to input data to be encode.
+  * @param  jk_in Pointer to J/K flags bitmap of input data.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Encode result ok (true/false).
+  */
+bool CDPEncodeCache::encode_symbols(const uint8_t* data_in,
+        const uint8_t* jk_in, const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    // Check if number of bytes to be encoded doesn't fit in output array
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    return this->encode_cached(data_in, jk_in, data_in_len, data_out,
+            current_signal_level);
+}
+
+/**
+  * @brief  Remove all the cached encodes and clear the counters.
+  */
+void CDPEncodeCache::reset(void)
+{
+    memset(this->buckets, CACHE_NONE, sizeof(this->buckets));
+    this->num_entries = 0;
+    this->lru_first = CACHE_NONE;
+    this->lru_last = CACHE_NONE;
+    this->hits = 0;
+    this->misses = 0;
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/**
+  * @brief  Get the number of encodes got from the cache.
+  * @return Number of cache hits.
+  */
+uint64_t CDPEncodeCache::get_hits(void)
+{
+    return this->hits;
+}
+
+/**
+  * @brief  Get the number of encodes not found in the cache (including data
+  * too long to be cached).
+  * @return Number of cache misses.
+  */
+uint64_t CDPEncodeCache::get_misses(void)
+{
+    return this->misses;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Get the encode from the cache (encoding and caching it if it is
+  * not there), and copy it for the current signal level.
+  * @param  data_in Pointer to input data to be encode.
+  * @param  jk_in Pointer to J/K flags bitmap of input data (NULL if none).
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  current_signal_level Pointer to current logic signal level.
+  * @return Encode result ok (true/false).
+  */
+bool CDPEncodeCache::encode_cached(const uint8_t* data_in,
+        const uint8_t* jk_in, const size_t data_in_len, uint8_t* data_out,
+        uint8_t* current_signal_level)
+{
+    cdp_cache_entry_t* entry = NULL;
+    uint64_t hash = 0;
+    uint8_t entry_n = CACHE_NONE;
+
+    // Data too long to be cached
+    if(data_in_len > CACHE_MAX_DATA_LEN)
+    {
+        this->misses = this->misses + 1;
+        if(jk_in == NULL)
+        {
+            return this->Cdp.encode(data_in, data_in_len, data_out,
+                    data_in_len*2, current_signal_level);
+        }
+        return this->Cdp.encode_symbols(data_in, jk_in, data_in_len,
+                data_out, data_in_len*2, current_signal_level);
+    }
+
+    hash = hash64(data_in, data_in_len, 0);
+    if(jk_in != NULL)
+        hash = hash64(jk_in, data_in_len, hash);
+    entry_n = this->find(hash, data_in, jk_in, data_in_len);
+    if(entry_n != CACHE_NONE)
+    {
+        this->hits = this->hits + 1;
+        this->lru_remove(entry_n);
+        this->lru_push_first(entry_n);
+    }
+    else
+    {
+        this->misses = this->misses + 1;
+        entry_n = this->insert(hash, data_in, jk_in, data_in_len);
+    }
+
+    // Cached chips are for HIGH level, inverted chips for LOW level
+    entry = &(this->entries[entry_n]);
+    if(*current_signal_level == LOGIC_LEVEL_HIGH)
+    {
+        memcpy(data_out, entry->chips, data_in_len*2);
+        *current_signal_level = entry->end_level;
+    }
+    else
+    {
+        copy_not(data_out, entry->chips, data_in_len*2);
+        *current_signal_level = entry->end_level ^ 0x01;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Find a cached encode.
+  * @param  hash Hash of the data (and J/K flags).
+  * @param  data_in Pointer to data.
+  * @param  jk_in Pointer to J/K flags (NULL if none).
+  * @param  data_in_len Number of bytes of data.
+  * @return Entry index (CACHE_NONE if not found).
+  */
+uint8_t CDPEncodeCache::find(const uint64_t hash, const uint8_t* data_in,
+        const uint8_t* jk_in, const size_t data_in_len)
+{
+    uint8_t entry_n = this->buckets[hash & (CACHE_BUCKETS - 1)];
+
+    while(entry_n != CACHE_NONE)
+    {
+        cdp_cache_entry_t* entry = &(this->entries[entry_n]);
+        if((entry->hash == hash) && (entry->data_len == data_in_len) &&
+           (entry->symbols == (jk_in != NULL)) &&
+           (memcmp(entry->data, data_in, data_in_len) == 0) &&
+           ((jk_in == NULL) || (memcmp(entry->jk, jk_in, data_in_len) == 0)))
+            return entry_n;
+        entry_n = entry->bucket_next;
+    }
+
+    return CACHE_NONE;
+}
+
+/**
+  * @brief  Encode data and cache it (in a free entry, or replacing the
+  * least recently used one).
+  * @param  hash Hash of the data (and J/K flags).
+  * @param  data_in Pointer to data.
+  * @param  jk_in Pointer to J/K flags (NULL if none).
+  * @param  data_in_len Number of bytes of data.
+  * @return Entry index.
+  */
+uint8_t CDPEncodeCache::insert(const uint64_t hash, const uint8_t* data_in,
+        const uint8_t* jk_in, const size_t data_in_len)
+{
+    cdp_cache_entry_t* entry = NULL;
+    uint8_t entry_n = CACHE_NONE;
+    uint8_t* bucket = NULL;
+
+    if(this->num_entries < CACHE_ENTRIES)
+    {
+        entry_n = this->num_entries;
+        this->num_entries = this->num_entries + 1;
+    }
+    else
+    {
+        // Evict least recently used entry (unlink it from its bucket)
+        entry_n = this->lru_last;
+        this->lru_remove(entry_n);
+        bucket = &(this->buckets[this->entries[entry_n].hash &
+                (CACHE_BUCKETS - 1)]);
+        while(*bucket != entry_n)
+            bucket = &(this->entries[*bucket].bucket_next);
+        *bucket = this->entries[entry_n].bucket_next;
+    }
+
+    entry = &(this->entries[entry_n]);
+    entry->hash = hash;
+    entry->data_len = (uint16_t)data_in_len;
+    entry->symbols = (jk_in != NULL);
+    entry->end_level = LOGIC_LEVEL_HIGH;
+    memcpy(entry->data, data_in, data_in_len);
+    if(jk_in != NULL)
+    {
+        memcpy(entry->jk, jk_in, data_in_len);
+        this->Cdp.encode_symbols(data_in, jk_in, data_in_len, entry->chips,
+                data_in_len*2, &(entry->end_level));
+    }
+    else
+    {
+        this->Cdp.encode(data_in, data_in_len, entry->chips, data_in_len*2,
+                &(entry->end_level));
+    }
+
+    bucket = &(this->buckets[hash & (CACHE_BUCKETS - 1)]);
+    entry->bucket_next = *bucket;
+    *bucket = entry_n;
+    this->lru_push_first(entry_n);
+
+    return entry_n;
+}
+
+/**
+  * @brief  Unlink an entry from the recently used list.
+  * @param  entry_n Entry index.
+  */
+void CDPEncodeCache::lru_remove(const uint8_t entry_n)
+{
+    cdp_cache_entry_t* entry = &(this->entries[entry_n]);
+
+    if(entry->lru_prev != CACHE_NONE)
+        this->entries[entry->lru_prev].lru_next = entry->lru_next;
+    else
+        this->lru_first = entry->lru_next;
+    if(entry->lru_next != CACHE_NONE)
+        this->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    else
+        this->lru_last = entry->lru_prev;
+}
+
+/**
+  * @brief  Link an entry as the most recently used one.
+  * @param  entry_n Entry index.
+  */
+void CDPEncodeCache::lru_push_first(const uint8_t entry_n)
+{
+    cdp_cache_entry_t* entry = &(this->entries[entry_n]);
+
+    entry->lru_prev = CACHE_NONE;
+    entry->lru_next = this->lru_first;
+    if(this->lru_first != CACHE_NONE)
+        this->entries[this->lru_first].lru_prev = entry_n;
+    else
+        this->lru_last = entry_n;
+    this->lru_first = entry_n;
+}
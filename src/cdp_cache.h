@@ -0,0 +1,132 @@
+/**
+ * @file    cdp_cache.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Least recently used cache of encoded data, for traffic with many equal
+ * frames (tokens, active monitor present, beacons...), so encoding them
+ * again is a copy of the cached chips. Each entry serves both starting
+ * signal levels (the chips of the opposite level are the inverted chips).
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_CACHE_H_
+#define CDP_CACHE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Number of cached encodes
+#define CACHE_ENTRIES 64
+
+// Longest data cached (longer data is encoded without cache)
+#define CACHE_MAX_DATA_LEN 256
+
+// Hash table buckets (power of 2)
+#define CACHE_BUCKETS 128
+
+// No entry index
+#define CACHE_NONE 0xFF
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Cached encode (chips for HIGH starting level) */
+typedef struct
+{
+    uint64_t hash;
+    uint8_t data[CACHE_MAX_DATA_LEN];
+    uint8_t jk[CACHE_MAX_DATA_LEN];
+    uint8_t chips[CACHE_MAX_DATA_LEN*2];
+    uint16_t data_len;
+    bool symbols;           // Encoded with J/K symbols
+    uint8_t end_level;      // Signal level after the chips
+    uint8_t bucket_next;    // Next entry of the same hash bucket
+    uint8_t lru_prev;       // More recently used entry
+    uint8_t lru_next;       // Less recently used entry
+} cdp_cache_entry_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPEncodeCache
+{
+    public:
+
+        CDPEncodeCache();
+        ~CDPEncodeCache();
+
+        bool encode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool encode_symbols(const uint8_t* data_in, const uint8_t* jk_in,
+                const size_t data_in_len, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+        void reset(void);
+
+        uint64_t get_hits(void);
+        uint64_t get_misses(void);
+
+    private:
+
+        CDP Cdp;
+        cdp_cache_entry_t entries[CACHE_ENTRIES];
+        uint8_t buckets[CACHE_BUCKETS];
+        uint8_t num_entries;
+        uint8_t lru_first;
+        uint8_t lru_last;
+        uint64_t hits;
+        uint64_t misses;
+
+        bool encode_cached(const uint8_t* data_in, const uint8_t* jk_in,
+                const size_t data_in_len, uint8_t* data_out,
+                uint8_t* current_signal_level);
+        uint8_t find(const uint64_t hash, const uint8_t* data_in,
+                const uint8_t* jk_in, const size_t data_in_len);
+        uint8_t insert(const uint64_t hash, const uint8_t* data_in,
+                const uint8_t* jk_in, const size_t data_in_len);
+        void lru_remove(const uint8_t entry_n);
+        void lru_push_first(const uint8_t entry_n);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_CACHE_H_ */
@@ -0,0 +1,641 @@
+/**
+ * @file    cdp_capture.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Capture files importer (VCD and sigrok raw binary logic dumps) that
+ * feeds the streaming decoders.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cdp_capture.h"
+#include "cdp.h"
+#include "cdp_bits.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Capture import modes
+#define CAPTURE_MODE_VCD    0
+#define CAPTURE_MODE_SIGROK 1
+
+// VCD parser states
+#define VCD_STATE_HEADER      0
+#define VCD_STATE_VAR         1
+#define VCD_STATE_HEADER_SKIP 2
+#define VCD_STATE_BODY        3
+#define VCD_STATE_BODY_SKIP   4
+#define VCD_STATE_VECTOR_ID   5
+
+// Fields of a VCD "$var type size id reference $end" declaration
+#define VCD_VAR_FIELD_ID  2
+#define VCD_VAR_FIELD_REF 3
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Check if a VCD character is a token separator (any control
+  * character or space).
+  * @param  c Character to check.
+  * @return Separator check result (true/false).
+  */
+static inline bool IS_VCD_SPACE(const char c)
+{   return ((uint8_t)c <= ' ');   }
+
+/**
+  * @brief  Check if a token is equal to a null terminated string.
+  * @param  token Pointer to token characters (not null terminated).
+  * @param  token_len Number of characters of the token.
+  * @param  str String to compare with.
+  * @return Compare result (true if equal).
+  */
+static inline bool TOKEN_IS(const char* token, const size_t token_len,
+        const char* str)
+{
+    return ((strlen(str) == token_len) &&
+            (memcmp(token, str, token_len) == 0));
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPCapture constructor */
+CDPCapture::CDPCapture()
+{
+    this->vcd_setup("", 1.0, NULL, 0, NULL, NULL);
+    this->sigrok_setup(1, 0, 1.0, NULL, 0, NULL, NULL);
+}
+
+/* CDPCapture destructor */
+CDPCapture::~CDPCapture()
+{}
+
+/*****************************************************************************/
+
+/* VCD Import Methods */
+
+/**
+  * @brief  Setup a VCD streaming import. The chosen signal value changes
+  * are converted to edge timestamps and decoded with CDPEdges (the first
+  * chip of each frame must be opposite to the signal initial value).
+  * @param  signal_name Reference name of the signal in the VCD "$var"
+  * declarations (the string must remain valid during the import).
+  * @param  ticks_per_chip Nominal chip duration in VCD time units.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at flush (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Setup result ok (true/false).
+  */
+bool CDPCapture::vcd_setup(const char* signal_name,
+        const float ticks_per_chip, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    if((signal_name == NULL) || (ticks_per_chip < 1.0))
+        return false;
+
+    this->signal_name = signal_name;
+    this->ticks_per_chip = ticks_per_chip;
+    this->data_out = data_out;
+    this->data_out_len = data_out_len;
+    this->callback = callback;
+    this->callback_arg = callback_arg;
+    this->mode = CAPTURE_MODE_VCD;
+    this->error = false;
+
+    this->vcd_state = VCD_STATE_HEADER;
+    this->var_field = 0;
+    this->var_match = false;
+    this->var_id[0] = '\0';
+    this->signal_id[0] = '\0';
+    this->token_len = 0;
+    this->vector_value = 0;
+    this->signal_level = 0;
+    this->signal_level_known = false;
+    this->time = 0;
+    this->num_buffered_edges = 0;
+    this->num_edges = 0;
+    this->Edges.setup(ticks_per_chip, LOGIC_LEVEL_LOW, LOGIC_LEVEL_HIGH,
+            data_out, data_out_len, callback, callback_arg);
+
+    return true;
+}
+
+/**
+  * @brief  Parse a piece of VCD text. It can be called successive times
+  * with consecutive pieces of the file, split at any point (tokens cut at
+  * the end of a piece are kept until the next one). Tokens fully inside a
+  * piece are processed in place without copying them.
+  * @param  text Pointer to VCD text.
+  * @param  text_len Number of characters of the text.
+  * @return Parse result ok (true/false on format error or decode overflow).
+  */
+bool CDPCapture::vcd_parse(const char* text, const size_t text_len)
+{
+    size_t i = 0;
+
+    if(this->error)
+        return false;
+
+    while(i < text_len)
+    {
+        size_t token_start = i;
+
+        // Find the end of the token
+        while((i < text_len) && !IS_VCD_SPACE(text[i]))
+            i = i + 1;
+
+        // Token cut at the end of the piece, keep it for the next one
+        if(i >= text_len)
+        {
+            size_t cut_len = i - token_start;
+            if(this->token_len + cut_len > CAPTURE_VCD_TOKEN_MAX_LEN)
+                cut_len = CAPTURE_VCD_TOKEN_MAX_LEN - this->token_len;
+            memcpy(this->token + this->token_len, text + token_start,
+                    cut_len);
+            this->token_len = this->token_len + cut_len;
+            break;
+        }
+
+        // Process the token (joining the part from previous piece, if any)
+        if(this->token_len > 0)
+        {
+            size_t cut_len = i - token_start;
+            if(this->token_len + cut_len > CAPTURE_VCD_TOKEN_MAX_LEN)
+                cut_len = CAPTURE_VCD_TOKEN_MAX_LEN - this->token_len;
+            memcpy(this->token + this->token_len, text + token_start,
+                    cut_len);
+            if(this->vcd_token(this->token, this->token_len + cut_len)
+                    == false)
+                return false;
+            this->token_len = 0;
+        }
+        else if(i > token_start)
+        {
+            if(this->vcd_token(text + token_start, i - token_start) == false)
+                return false;
+        }
+
+        // Skip separators
+        while((i < text_len) && IS_VCD_SPACE(text[i]))
+            i = i + 1;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  End of VCD text. Pending token and buffered edges are processed
+  * and decoded bytes pending in the output array are flushed to callback.
+  * @return Flush result ok (true/false).
+  */
+bool CDPCapture::vcd_flush(void)
+{
+    if((this->token_len > 0) && (this->error == false))
+    {
+        this->vcd_token(this->token, this->token_len);
+        this->token_len = 0;
+    }
+    if(this->vcd_edges_flush() == false)
+        return false;
+    if(this->Edges.flush() == false)
+        this->error = true;
+
+    return !(this->error);
+}
+
+/**
+  * @brief  Import and decode a VCD file, reading it in fixed size chunks.
+  * @param  file_path Path of the VCD file.
+  * @param  signal_name Reference name of the signal to decode.
+  * @param  ticks_per_chip Nominal chip duration in VCD time units.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at the end (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Import result ok (true/false).
+  */
+bool CDPCapture::import_vcd(const char* file_path, const char* signal_name,
+        const float ticks_per_chip, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    char text[CAPTURE_READ_CHUNK_SIZE];
+    size_t text_len = 0;
+    bool result = true;
+    FILE* file = NULL;
+
+    if(this->vcd_setup(signal_name, ticks_per_chip, data_out, data_out_len,
+            callback, callback_arg) == false)
+        return false;
+
+    file = fopen(file_path, "rb");
+    if(file == NULL)
+        return false;
+    do
+    {
+        text_len = fread(text, 1, sizeof(text), file);
+        result = this->vcd_parse(text, text_len);
+    } while(result && (text_len == sizeof(text)));
+    fclose(file);
+
+    return (this->vcd_flush() && result);
+}
+
+/*****************************************************************************/
+
+/* sigrok Import Methods */
+
+/**
+  * @brief  Setup a sigrok raw binary logic import (as generated by
+  * "sigrok-cli -O binary"): each sample is a little-endian unit of
+  * unit_size bytes with one bit per channel. The chosen channel is packed
+  * to an oversampled bitstream and decoded with CDPOversampled.
+  * @param  unit_size Bytes of each sample unit (1 to 8).
+  * @param  channel Channel number (bit of the sample unit).
+  * @param  samples_per_chip Nominal samples for each chip.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at flush (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Setup result ok (true/false).
+  */
+bool CDPCapture::sigrok_setup(const uint8_t unit_size, const uint8_t channel,
+        const float samples_per_chip, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    if((unit_size == 0) || (unit_size > 8) || (channel >= unit_size*8))
+        return false;
+
+    this->unit_size = unit_size;
+    this->channel = channel;
+    this->unit_i = 0;
+    this->samples_byte = 0x00;
+    this->samples_byte_bits = 0;
+    this->num_samples_bytes = 0;
+    this->mode = CAPTURE_MODE_SIGROK;
+    this->error = false;
+
+    return this->Oversampled.setup(samples_per_chip, data_out, data_out_len,
+            callback, callback_arg);
+}
+
+/**
+  * @brief  Parse a piece of sigrok raw binary logic data. It can be called
+  * successive times with consecutive pieces of the data, split at any
+  * point. For 1 byte units, channel bits of 8 samples are gathered at once.
+  * @param  data Pointer to sample units data.
+  * @param  data_len Number of bytes of data.
+  * @return Parse result ok (true/false on decode overflow).
+  */
+bool CDPCapture::sigrok_parse(const uint8_t* data, const size_t data_len)
+{
+    size_t i = 0;
+
+    if(this->error)
+        return false;
+
+    while(i < data_len)
+    {
+        // Fast path: 8 samples of 1 byte units at once
+        if((this->unit_size == 1) && (this->unit_i == 0) &&
+           (this->samples_byte_bits == 0) && (i + 8 <= data_len))
+        {
+            uint64_t word = load_le64(data + i) >> this->channel;
+            this->samples[this->num_samples_bytes] = pack_bytes_lsb64(word);
+            this->num_samples_bytes = this->num_samples_bytes + 1;
+            if(this->num_samples_bytes >= sizeof(this->samples))
+            {
+                if(this->sigrok_sample(0xFF) == false)
+                    return false;
+            }
+            i = i + 8;
+            continue;
+        }
+
+        // Generic path: one sample unit byte at a time
+        this->unit[this->unit_i] = data[i];
+        this->unit_i = this->unit_i + 1;
+        i = i + 1;
+        if(this->unit_i < this->unit_size)
+            continue;
+        this->unit_i = 0;
+        if(this->sigrok_sample((this->unit[this->channel / 8] >>
+                (this->channel % 8)) & 0x01) == false)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  End of sigrok data. Buffered samples are decoded and decoded
+  * bytes pending in the output array are flushed to callback.
+  * @return Flush result ok (true/false).
+  */
+bool CDPCapture::sigrok_flush(void)
+{
+    // Pad the last incomplete samples byte with the last sample level
+    if(this->samples_byte_bits > 0)
+    {
+        uint8_t last = (this->samples_byte >> (this->samples_byte_bits - 1))
+                & 0x01;
+        while(this->samples_byte_bits > 0)
+            this->sigrok_sample(last);
+    }
+    if(this->num_samples_bytes > 0)
+    {
+        if(this->Oversampled.decode(this->samples, this->num_samples_bytes)
+                == false)
+            this->error = true;
+        this->num_samples_bytes = 0;
+    }
+    if(this->Oversampled.flush() == false)
+        this->error = true;
+
+    return !(this->error);
+}
+
+/**
+  * @brief  Import and decode a sigrok raw binary logic file, reading it in
+  * fixed size chunks.
+  * @param  file_path Path of the binary logic file.
+  * @param  unit_size Bytes of each sample unit (1 to 8).
+  * @param  channel Channel number (bit of the sample unit).
+  * @param  samples_per_chip Nominal samples for each chip.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at the end (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Import result ok (true/false).
+  */
+bool CDPCapture::import_sigrok(const char* file_path, const uint8_t unit_size,
+        const uint8_t channel, const float samples_per_chip,
+        uint8_t* data_out, const size_t data_out_len, cdp_stream_cb callback,
+        void* callback_arg)
+{
+    uint8_t data[CAPTURE_READ_CHUNK_SIZE];
+    size_t data_len = 0;
+    bool result = true;
+    FILE* file = NULL;
+
+    if(this->sigrok_setup(unit_size, channel, samples_per_chip, data_out,
+            data_out_len, callback, callback_arg) == false)
+        return false;
+
+    file = fopen(file_path, "rb");
+    if(file == NULL)
+        return false;
+    do
+    {
+        data_len = fread(data, 1, sizeof(data), file);
+        result = this->sigrok_parse(data, data_len);
+    } while(result && (data_len == sizeof(data)));
+    fclose(file);
+
+    return (this->sigrok_flush() && result);
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get number of decoded bytes currently stored in the output array */
+size_t CDPCapture::get_decoded_len(void)
+{
+    if(this->mode == CAPTURE_MODE_VCD)
+        return this->Edges.get_decoded_len();
+    return this->Oversampled.get_decoded_len();
+}
+
+/* Get number of edges of the chosen signal found in the VCD capture */
+uint64_t CDPCapture::get_num_edges(void)
+{   return this->num_edges;   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Process a VCD token.
+  * @param  token Pointer to token characters (not null terminated).
+  * @param  token_len Number of characters of the token.
+  * @return Result ok (true/false on format error or decode overflow).
+  */
+bool CDPCapture::vcd_token(const char* token, const size_t token_len)
+{
+    switch(this->vcd_state)
+    {
+        // Declarations: just "$var" ones matter
+        case VCD_STATE_HEADER:
+            if(TOKEN_IS(token, token_len, "$var"))
+            {
+                this->vcd_state = VCD_STATE_VAR;
+                this->var_field = 0;
+                this->var_match = false;
+                this->var_id[0] = '\0';
+            }
+            else if(TOKEN_IS(token, token_len, "$enddefinitions"))
+            {
+                if(this->signal_id[0] == '\0')
+                {
+                    this->error = true;
+                    return false;
+                }
+                this->vcd_state = VCD_STATE_BODY;
+            }
+            else if(token[0] == '$')
+                this->vcd_state = VCD_STATE_HEADER_SKIP;
+            break;
+
+        // "$var type size id reference [bits] $end"
+        case VCD_STATE_VAR:
+            if(TOKEN_IS(token, token_len, "$end"))
+            {
+                if(this->var_match && (this->signal_id[0] == '\0') &&
+                   (this->var_id[0] != '\0'))
+                    strcpy(this->signal_id, this->var_id);
+                this->vcd_state = VCD_STATE_HEADER;
+            }
+            else if((this->var_field == VCD_VAR_FIELD_ID) &&
+                    (token_len <= CAPTURE_VCD_ID_MAX_LEN))
+            {
+                // (longer identifier codes keep var_id empty, so that
+                // variable can't be chosen and the signal is not found)
+                memcpy(this->var_id, token, token_len);
+                this->var_id[token_len] = '\0';
+            }
+            else if(this->var_field == VCD_VAR_FIELD_REF)
+                this->var_match = TOKEN_IS(token, token_len, this->signal_name);
+            this->var_field = this->var_field + 1;
+            break;
+
+        case VCD_STATE_HEADER_SKIP:
+            if(TOKEN_IS(token, token_len, "$end"))
+                this->vcd_state = VCD_STATE_HEADER;
+            break;
+
+        // Value changes
+        case VCD_STATE_BODY:
+            if(token[0] == '#')
+            {
+                uint64_t time = 0;
+                for(size_t i = 1; i < token_len; i++)
+                    time = (time * 10) + (uint8_t)(token[i] - '0');
+                this->time = time;
+            }
+            else if((token[0] == '0') || (token[0] == '1'))
+                return this->vcd_value(token[0] - '0', token + 1,
+                        token_len - 1);
+            else if((token[0] == 'b') || (token[0] == 'B'))
+            {
+                this->vector_value = (token[token_len - 1] == '1');
+                this->vcd_state = VCD_STATE_VECTOR_ID;
+            }
+            else if((token[0] == 'r') || (token[0] == 'R'))
+            {
+                this->vector_value = 0xFF;
+                this->vcd_state = VCD_STATE_VECTOR_ID;
+            }
+            else if(TOKEN_IS(token, token_len, "$comment"))
+                this->vcd_state = VCD_STATE_BODY_SKIP;
+            break;
+
+        case VCD_STATE_BODY_SKIP:
+            if(TOKEN_IS(token, token_len, "$end"))
+                this->vcd_state = VCD_STATE_BODY;
+            break;
+
+        case VCD_STATE_VECTOR_ID:
+            this->vcd_state = VCD_STATE_BODY;
+            if(this->vector_value != 0xFF)
+                return this->vcd_value(this->vector_value, token, token_len);
+            break;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Process a VCD value change, buffering an edge timestamp if it
+  * belongs to the chosen signal and changes its level (x/z values are not
+  * handled as changes). First value of the signal sets the idle level.
+  * @param  value New value (0 or 1).
+  * @param  id Pointer to identifier code characters (not null terminated).
+  * @param  id_len Number of characters of the identifier code.
+  * @return Result ok (true/false on decode overflow).
+  */
+bool CDPCapture::vcd_value(const uint8_t value, const char* id,
+        const size_t id_len)
+{
+    if(TOKEN_IS(id, id_len, this->signal_id) == false)
+        return true;
+
+    if(this->signal_level_known == false)
+    {
+        this->Edges.setup(this->ticks_per_chip, value, value ^ 0x01,
+                this->data_out, this->data_out_len, this->callback,
+                this->callback_arg);
+        this->signal_level = value;
+        this->signal_level_known = true;
+        return true;
+    }
+    if(value == this->signal_level)
+        return true;
+
+    this->signal_level = value;
+    this->edges[this->num_buffered_edges] = this->time;
+    this->num_buffered_edges = this->num_buffered_edges + 1;
+    this->num_edges = this->num_edges + 1;
+    if(this->num_buffered_edges >= CAPTURE_EDGES_BUFFER_SIZE)
+        return this->vcd_edges_flush();
+
+    return true;
+}
+
+/**
+  * @brief  Decode buffered edge timestamps.
+  * @return Result ok (true/false on decode overflow).
+  */
+bool CDPCapture::vcd_edges_flush(void)
+{
+    if(this->num_buffered_edges > 0)
+    {
+        if(this->Edges.decode(this->edges, this->num_buffered_edges) == false)
+            this->error = true;
+        this->num_buffered_edges = 0;
+    }
+    return !(this->error);
+}
+
+/**
+  * @brief  Add a sample to the packed samples buffer, decoding the buffer
+  * when it gets full. A 0xFF sample value just decodes the full buffer.
+  * @param  sample Sample level (0 or 1).
+  * @return Result ok (true/false on decode overflow).
+  */
+bool CDPCapture::sigrok_sample(const uint8_t sample)
+{
+    if(sample != 0xFF)
+    {
+        this->samples_byte = this->samples_byte |
+                (sample << this->samples_byte_bits);
+        this->samples_byte_bits = this->samples_byte_bits + 1;
+        if(this->samples_byte_bits < 8)
+            return true;
+        this->samples[this->num_samples_bytes] = this->samples_byte;
+        this->num_samples_bytes = this->num_samples_bytes + 1;
+        this->samples_byte = 0x00;
+        this->samples_byte_bits = 0;
+    }
+    if(this->num_samples_bytes >= sizeof(this->samples))
+    {
+        if(this->Oversampled.decode(this->samples, this->num_samples_bytes)
+                == false)
+        {
+            this->error = true;
+            return false;
+        }
+        this->num_samples_bytes = 0;
+    }
+
+    return true;
+}
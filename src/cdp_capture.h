@@ -0,0 +1,153 @@
+/**
+ * @file    cdp_capture.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Capture files importer that stream-parses Value Change Dump (VCD) text
+ * files and sigrok raw binary logic dumps, extracting the chosen signal
+ * and feeding it straight to the streaming decoders (as edge timestamps or
+ * as packed samples), using a constant amount of memory regardless of the
+ * capture length.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_CAPTURE_H_
+#define CDP_CAPTURE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp_stream.h"
+#include "cdp_edges.h"
+#include "cdp_oversampled.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Bytes read from capture files on each step
+#define CAPTURE_READ_CHUNK_SIZE 16384
+
+// Edge timestamps buffered before feeding them to the decoder
+#define CAPTURE_EDGES_BUFFER_SIZE 1024
+
+// Longest VCD token handled (longer ones are truncated)
+#define CAPTURE_VCD_TOKEN_MAX_LEN 255
+
+// Longest VCD signal identifier code handled
+#define CAPTURE_VCD_ID_MAX_LEN 15
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPCapture
+{
+    public:
+
+        CDPCapture();
+        ~CDPCapture();
+
+        bool vcd_setup(const char* signal_name, const float ticks_per_chip,
+                uint8_t* data_out, const size_t data_out_len,
+                cdp_stream_cb callback, void* callback_arg);
+        bool vcd_parse(const char* text, const size_t text_len);
+        bool vcd_flush(void);
+        bool import_vcd(const char* file_path, const char* signal_name,
+                const float ticks_per_chip, uint8_t* data_out,
+                const size_t data_out_len, cdp_stream_cb callback,
+                void* callback_arg);
+
+        bool sigrok_setup(const uint8_t unit_size, const uint8_t channel,
+                const float samples_per_chip, uint8_t* data_out,
+                const size_t data_out_len, cdp_stream_cb callback,
+                void* callback_arg);
+        bool sigrok_parse(const uint8_t* data, const size_t data_len);
+        bool sigrok_flush(void);
+        bool import_sigrok(const char* file_path, const uint8_t unit_size,
+                const uint8_t channel, const float samples_per_chip,
+                uint8_t* data_out, const size_t data_out_len,
+                cdp_stream_cb callback, void* callback_arg);
+
+        size_t get_decoded_len(void);
+        uint64_t get_num_edges(void);
+
+    private:
+
+        CDPEdges Edges;
+        CDPOversampled Oversampled;
+
+        uint8_t* data_out;
+        size_t data_out_len;
+        cdp_stream_cb callback;
+        void* callback_arg;
+        uint8_t mode;
+        bool error;
+
+        // VCD parser state
+        const char* signal_name;
+        float ticks_per_chip;
+        uint8_t vcd_state;
+        uint8_t var_field;
+        bool var_match;
+        char var_id[CAPTURE_VCD_ID_MAX_LEN + 1];
+        char signal_id[CAPTURE_VCD_ID_MAX_LEN + 1];
+        char token[CAPTURE_VCD_TOKEN_MAX_LEN + 1];
+        size_t token_len;
+        uint8_t vector_value;
+        uint8_t signal_level;
+        bool signal_level_known;
+        uint64_t time;
+        uint64_t edges[CAPTURE_EDGES_BUFFER_SIZE];
+        size_t num_buffered_edges;
+        uint64_t num_edges;
+
+        // sigrok parser state
+        uint8_t unit_size;
+        uint8_t channel;
+        uint8_t unit[8];
+        uint8_t unit_i;
+        uint8_t samples_byte;
+        uint8_t samples_byte_bits;
+        uint8_t samples[CAPTURE_READ_CHUNK_SIZE / 8];
+        size_t num_samples_bytes;
+
+        bool vcd_token(const char* token, const size_t token_len);
+        bool vcd_value(const uint8_t value, const char* id,
+                const size_t id_len);
+        bool vcd_edges_flush(void);
+        bool sigrok_sample(const uint8_t sample);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_CAPTURE_H_ */
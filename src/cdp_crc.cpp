@@ -0,0 +1,491 @@
+/**
+ * @file    cdp_crc.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802 CRC-32 (frame check sequence) computation.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_crc.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+#if defined(__PCLMUL__) && defined(__SSE2__)
+    #include <wmmintrin.h>
+    #include <emmintrin.h>
+#endif
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Reflected CRC-32 polynomial (0x04C11DB7) remainders of each nibble value
+static const uint32_t CRC32_NIBBLE_TABLE[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+// Minimum number of bytes to use carry-less multiply folding
+#define CRC32_FOLD_MIN_LEN 64
+
+/*****************************************************************************/
+
+/* In-Scope Functions */
+
+#if defined(__PCLMUL__) && defined(__SSE2__)
+
+/**
+  * @brief  Update a CRC-32 register folding 16 bytes blocks with carry-less
+  * multiplications (four 128 bits lanes in parallel), and reducing the
+  * result to 32 bits with Barrett reduction.
+  * @param  crc CRC-32 register value.
+  * @param  data Pointer to the data (at least 64 bytes).
+  * @param  data_len Number of bytes (a multiple of 16).
+  * @return Updated CRC-32 register value.
+  */
+static uint32_t CRC32_FOLD(uint32_t crc, const uint8_t* data, size_t data_len)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163CD6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x1, x2, x3, x4, y1, y2, y3, y4;
+
+    x1 = _mm_loadu_si128((const __m128i*)(data + 0x00));
+    x2 = _mm_loadu_si128((const __m128i*)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i*)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i*)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    data = data + 64;
+    data_len = data_len - 64;
+
+    // Fold 64 bytes blocks in four lanes
+    while(data_len >= 64)
+    {
+        y1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        y2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        y3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        y4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1),
+                _mm_loadu_si128((const __m128i*)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, y2),
+                _mm_loadu_si128((const __m128i*)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, y3),
+                _mm_loadu_si128((const __m128i*)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, y4),
+                _mm_loadu_si128((const __m128i*)(data + 0x30)));
+        data = data + 64;
+        data_len = data_len - 64;
+    }
+
+    // Fold the four lanes into one
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), y1);
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), y1);
+    y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), y1);
+
+    // Fold remaining 16 bytes blocks
+    while(data_len >= 16)
+    {
+        y1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, y1),
+                _mm_loadu_si128((const __m128i*)data));
+        data = data + 16;
+        data_len = data_len - 16;
+    }
+
+    // Fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+/**
+  * @brief  Carry-less multiply two 64 bits words.
+  * @param  a First word.
+  * @param  b Second word.
+  * @param  high Pointer to store the high 64 bits of the product.
+  * @return Low 64 bits of the product.
+  */
+static inline uint64_t CLMUL64(const uint64_t a, const uint64_t b,
+        uint64_t* high)
+{
+    __m128i x = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a),
+            _mm_cvtsi64_si128((long long)b), 0x00);
+    *high = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(x, x));
+    return (uint64_t)_mm_cvtsi128_si64(x);
+}
+
+#endif
+
+/**
+  * @brief  Reverse the bits order of a CRC register value.
+  * @param  value Register value.
+  * @param  width Register width in bits.
+  * @return Reflected value.
+  */
+static inline uint32_t CRC_REFLECT(const uint32_t value, const uint8_t width)
+{   return (uint32_t)(bswap64(reverse_bits8x8(value)) >> (64 - width));   }
+
+/**
+  * @brief  Square a CRC-32 register linear operator matrix.
+  * @param  square Pointer to store the squared matrix.
+  * @param  matrix Pointer to the matrix.
+  */
+static void CRC32_MATRIX_SQUARE(uint32_t* square, const uint32_t* matrix)
+{
+    for(uint8_t i = 0; i < CRC32_MATRIX_ROWS; i++)
+        square[i] = crc32_matrix_times(matrix, matrix[i]);
+}
+
+/*****************************************************************************/
+
+/* Functions */
+
+/**
+  * @brief  Update a CRC-32 register with a block of data. Blocks can be
+  * given in any number of calls (starting from CRC32_INIT register value).
+  * @param  crc CRC-32 register value.
+  * @param  data Pointer to the data.
+  * @param  data_len Number of bytes of data.
+  * @return Updated CRC-32 register value.
+  */
+uint32_t crc32_update(uint32_t crc, const uint8_t* data,
+        const size_t data_len)
+{
+    size_t i = 0;
+
+    #if defined(__PCLMUL__) && defined(__SSE2__)
+        if(data_len >= CRC32_FOLD_MIN_LEN)
+        {
+            i = data_len & ~((size_t)0x0F);
+            crc = CRC32_FOLD(crc, data, i);
+        }
+    #endif
+    for(; i < data_len; i++)
+    {
+        crc = crc ^ data[i];
+        crc = (crc >> 4) ^ CRC32_NIBBLE_TABLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC32_NIBBLE_TABLE[crc & 0x0F];
+    }
+
+    return crc;
+}
+
+/**
+  * @brief  Get the linear operator (GF(2) matrix) that advances a CRC-32
+  * register over a number of zero bytes. As the CRC is linear, it allows
+  * to get the CRC change due to a change of some bytes of a block, without
+  * processing the bytes that follow them.
+  * @param  matrix Pointer to store the matrix (CRC32_MATRIX_ROWS words).
+  * @param  num_zeros Number of zero bytes.
+  */
+void crc32_zeros_matrix(uint32_t* matrix, size_t num_zeros)
+{
+    uint32_t power[CRC32_MATRIX_ROWS];
+    uint32_t square[CRC32_MATRIX_ROWS];
+
+    // Identity result, and operator for one zero bit
+    for(uint8_t i = 0; i < CRC32_MATRIX_ROWS; i++)
+        matrix[i] = ((uint32_t)1 << i);
+    power[0] = 0xEDB88320;
+    for(uint8_t i = 1; i < CRC32_MATRIX_ROWS; i++)
+        power[i] = ((uint32_t)1 << (i - 1));
+
+    // Operator for one zero byte (8 zero bits)
+    CRC32_MATRIX_SQUARE(square, power);
+    CRC32_MATRIX_SQUARE(power, square);
+    CRC32_MATRIX_SQUARE(square, power);
+    memcpy(power, square, sizeof(power));
+
+    // Operator powers for each bit of the number of zero bytes
+    while(num_zeros > 0)
+    {
+        if(num_zeros & 0x01)
+        {
+            for(uint8_t i = 0; i < CRC32_MATRIX_ROWS; i++)
+                square[i] = crc32_matrix_times(power, matrix[i]);
+            memcpy(matrix, square, sizeof(square));
+        }
+        num_zeros = num_zeros >> 1;
+        if(num_zeros > 0)
+        {
+            CRC32_MATRIX_SQUARE(square, power);
+            memcpy(power, square, sizeof(power));
+        }
+    }
+}
+
+/**
+  * @brief  Apply a CRC-32 register linear operator matrix.
+  * @param  matrix Pointer to the matrix (CRC32_MATRIX_ROWS words).
+  * @param  crc CRC-32 register value.
+  * @return Resulting CRC-32 register value.
+  */
+uint32_t crc32_matrix_times(const uint32_t* matrix, uint32_t crc)
+{
+    uint32_t result = 0;
+
+    for(uint8_t i = 0; crc != 0; i++)
+    {
+        if(crc & 0x01)
+            result = result ^ matrix[i];
+        crc = crc >> 1;
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPCrc constructor */
+CDPCrc::CDPCrc()
+{
+    this->setup(32, 0x04C11DB7, CRC32_INIT, true, 0xFFFFFFFF);
+}
+
+/* CDPCrc destructor */
+CDPCrc::~CDPCrc()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup the CRC parameters (Rocksoft model: the register is
+  * shifted MSb first, so the polynomial and initial value are given in
+  * that order) and reset the register. Default setup is the IEEE 802
+  * CRC-32 (width 32, polynomial 0x04C11DB7, reflected, all ones initial
+  * and output xor values).
+  * @param  width Register width in bits (CRC_MIN_WIDTH to CRC_MAX_WIDTH,
+  * multiple of 8).
+  * @param  polynomial Polynomial without the x^width term.
+  * @param  init Register initial value.
+  * @param  reflected Input bytes processed LSb first and register value
+  * reflected at output (the FCS is then sent as little-endian bytes,
+  * otherwise as big-endian bytes).
+  * @param  xor_out Value xored to the register at output.
+  * @return Setup result ok (true/false).
+  */
+bool CDPCrc::setup(const uint8_t width, const uint32_t polynomial,
+        const uint32_t init, const bool reflected, const uint32_t xor_out)
+{
+    uint64_t window = 1ULL << width;
+    uint32_t fcs = 0;
+
+    if((width < CRC_MIN_WIDTH) || (width > CRC_MAX_WIDTH) ||
+       (width % 8 != 0) || (polynomial == 0))
+        return false;
+
+    this->width = width;
+    this->mask = (uint32_t)((1ULL << width) - 1);
+    this->polynomial = polynomial & this->mask;
+    this->init = init & this->mask;
+    this->reflected = reflected;
+    this->xor_out = xor_out & this->mask;
+
+    // Register update for each byte value (MSb first)
+    for(uint16_t b = 0; b < 256; b++)
+    {
+        uint32_t r = (uint32_t)b << (width - 8);
+        for(uint8_t i = 0; i < 8; i++)
+        {
+            if((r >> (width - 1)) & 0x01)
+                r = (r << 1) ^ this->polynomial;
+            else
+                r = r << 1;
+        }
+        this->table[b] = r & this->mask;
+    }
+
+    // Barrett constant: low 64 bits of x^(64 + width) / P (x^64 implicit)
+    this->barrett = 0;
+    for(int8_t d = 64; d >= 0; d--)
+    {
+        if((window >> width) & 0x01)
+        {
+            if(d < 64)
+                this->barrett = this->barrett | (1ULL << d);
+            window = window ^ ((1ULL << width) | this->polynomial);
+        }
+        window = window << 1;
+    }
+
+    // Register value after any block followed by its FCS
+    this->reset();
+    fcs = this->get_crc();
+    for(uint8_t i = 0; i < width / 8; i++)
+    {
+        if(reflected)
+            this->update_byte((uint8_t)(fcs >> (8*i)));
+        else
+            this->update_byte((uint8_t)(fcs >> (width - 8 - 8*i)));
+    }
+    this->residue = this->crc;
+    this->reset();
+
+    return true;
+}
+
+/**
+  * @brief  Reset the register to its initial value (start of a block).
+  */
+void CDPCrc::reset(void)
+{
+    this->crc = this->init;
+}
+
+/*****************************************************************************/
+
+/* Update Methods */
+
+/**
+  * @brief  Update the register with a block of data. Blocks can be given in
+  * any number of calls.
+  * @param  data Pointer to the data.
+  * @param  data_len Number of bytes of data.
+  */
+void CDPCrc::update(const uint8_t* data, const size_t data_len)
+{
+    size_t i = 0;
+
+    for(; i + 8 <= data_len; i = i + 8)
+        this->update_word(load_le64(data + i), 8);
+    if(i < data_len)
+        this->update_word(load_le64_len(data + i, (uint8_t)(data_len - i)),
+                (uint8_t)(data_len - i));
+}
+
+/**
+  * @brief  Update the register with up to 8 bytes given in a word, as
+  * decoders get them. A full word is appended to the register at once:
+  * the new register is (register * x^64 + word * x^width) mod P, with the
+  * quotient got from a carry-less multiply by the Barrett constant and the
+  * remainder from a carry-less multiply by the polynomial (byte by byte
+  * with the table when the target has no PCLMULQDQ).
+  * @param  word Data bytes (little-endian, first byte in the low bits).
+  * @param  num_bytes Number of bytes of the word (1 to 8).
+  */
+void CDPCrc::update_word(const uint64_t word, const uint8_t num_bytes)
+{
+    uint64_t data = word;
+
+    if(num_bytes < 8)
+    {
+        for(uint8_t i = 0; i < num_bytes; i++)
+            this->update_byte((uint8_t)(word >> (8*i)));
+        return;
+    }
+
+    // Data bits in sending order from the MSb
+    if(this->reflected)
+        data = reverse_bits8x8(data);
+    data = bswap64(data);
+
+    #if defined(__PCLMUL__) && defined(__SSE2__)
+        uint64_t high = 0;
+        data = data ^ ((uint64_t)this->crc << (64 - this->width));
+        CLMUL64(data, this->barrett, &high);
+        this->crc = (uint32_t)CLMUL64(data ^ high, this->polynomial, &high) &
+                this->mask;
+    #else
+        for(uint8_t i = 0; i < 8; i++)
+        {
+            this->crc = ((this->crc << 8) ^ this->table[((this->crc >>
+                    (this->width - 8)) ^ (data >> (56 - 8*i))) & 0xFF]) &
+                    this->mask;
+        }
+    #endif
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get the CRC value of the data given since last reset */
+uint32_t CDPCrc::get_crc(void)
+{
+    uint32_t value = this->crc;
+
+    if(this->reflected)
+        value = CRC_REFLECT(value, this->width);
+    return ((value ^ this->xor_out) & this->mask);
+}
+
+/* Get if the data given since last reset ends with its right FCS */
+bool CDPCrc::get_fcs_ok(void)
+{   return (this->crc == this->residue);   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Update the register with one byte.
+  * @param  data_byte Data byte.
+  */
+void CDPCrc::update_byte(const uint8_t data_byte)
+{
+    uint8_t data = data_byte;
+
+    if(this->reflected)
+        data = reverse_bits8(data);
+    this->crc = ((this->crc << 8) ^ this->table[((this->crc >>
+            (this->width - 8)) ^ data) & 0xFF]) & this->mask;
+}
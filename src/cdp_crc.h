@@ -0,0 +1,124 @@
+/**
+ * @file    cdp_crc.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802 CRC-32 (frame check sequence) computation, with carry-less
+ * multiply folding when the target supports it (PCLMULQDQ), and CRCs with
+ * configurable width, polynomial and reflection updated 64 bits at once
+ * (to be fed by decoders with the data words they have in registers).
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_CRC_H_
+#define CDP_CRC_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// CRC-32 initial register value and residue of a block followed by its FCS
+#define CRC32_INIT    0xFFFFFFFF
+#define CRC32_RESIDUE 0xDEBB20E3
+
+// Bytes of the frame check sequence
+#define CRC32_FCS_LEN 4
+
+// Rows of a CRC-32 register linear operator matrix (GF(2) 32x32 matrix)
+#define CRC32_MATRIX_ROWS 32
+
+// Configurable CRC widths (multiple of 8 bits, so the FCS is whole bytes)
+#define CRC_MIN_WIDTH 8
+#define CRC_MAX_WIDTH 32
+
+/*****************************************************************************/
+
+/* Functions Prototypes */
+
+uint32_t crc32_update(uint32_t crc, const uint8_t* data,
+        const size_t data_len);
+void crc32_zeros_matrix(uint32_t* matrix, size_t num_zeros);
+uint32_t crc32_matrix_times(const uint32_t* matrix, uint32_t crc);
+
+/**
+  * @brief  Get the frame check sequence value from a CRC-32 register.
+  * @param  crc CRC-32 register value.
+  * @return Frame check sequence (sent as little-endian bytes).
+  */
+static inline uint32_t crc32_final(const uint32_t crc)
+{   return (crc ^ 0xFFFFFFFF);   }
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPCrc
+{
+    public:
+
+        CDPCrc();
+        ~CDPCrc();
+
+        bool setup(const uint8_t width, const uint32_t polynomial,
+                const uint32_t init, const bool reflected,
+                const uint32_t xor_out);
+        void reset(void);
+
+        void update(const uint8_t* data, const size_t data_len);
+        void update_word(const uint64_t word, const uint8_t num_bytes);
+
+        uint32_t get_crc(void);
+        bool get_fcs_ok(void);
+
+    private:
+
+        uint8_t width;
+        uint32_t polynomial;
+        uint32_t init;
+        bool reflected;
+        uint32_t xor_out;
+        uint32_t mask;
+        uint64_t barrett;
+        uint32_t residue;
+        uint32_t crc;
+        uint32_t table[256];
+
+        void update_byte(const uint8_t data_byte);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_CRC_H_ */
@@ -0,0 +1,304 @@
+/**
+ * @file    cdp_delimiter.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) starting and ending delimiters scanner.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_delimiter.h"
+#include "cdp_bits.h"
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Chips matched for ending delimiters (JK1JK1, I and E bits are data that
+// only need a middle transition)
+#define ED_MATCH_CHIPS 12
+
+// Delimiters buffered on each step when looking for frames
+#define FRAMES_SCAN_BUFFER_SIZE 64
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Get a chip value from a packed chip stream.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  chip_n Chip position.
+  * @return Chip value (0 or 1).
+  */
+static inline uint8_t GET_CHIP(const uint8_t* chips, const uint64_t chip_n)
+{   return ((chips[chip_n / 8] >> (chip_n % 8)) & 0x01);   }
+
+/**
+  * @brief  Load 64 chips from any byte position of a packed chip stream,
+  * with zeros past its end.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_bytes Number of bytes of the chip stream.
+  * @param  byte_n Byte position to load from.
+  * @return Loaded chips.
+  */
+static inline uint64_t LOAD_CHIPS(const uint8_t* chips,
+        const uint64_t num_bytes, const uint64_t byte_n)
+{
+    if(byte_n + 8 <= num_bytes)
+        return load_le64(chips + byte_n);
+    if(byte_n >= num_bytes)
+        return 0;
+    return load_le64_len(chips + byte_n, (uint8_t)(num_bytes - byte_n));
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPDelimiterScanner constructor */
+CDPDelimiterScanner::CDPDelimiterScanner()
+{
+    CDP Cdp;
+    uint8_t data = DELIMITER_SD_DATA;
+    uint8_t jk = DELIMITER_SD_JK;
+    uint8_t chips[2];
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    // Get delimiters chips patterns for HIGH level before them
+    Cdp.encode_symbols(&data, &jk, 1, chips, 2, &level);
+    this->sd_pattern = (uint16_t)(chips[0] | (chips[1] << 8));
+    data = DELIMITER_ED_DATA;
+    jk = DELIMITER_ED_JK;
+    level = LOGIC_LEVEL_HIGH;
+    Cdp.encode_symbols(&data, &jk, 1, chips, 2, &level);
+    this->ed_pattern = (uint16_t)(chips[0] | (chips[1] << 8));
+}
+
+/* CDPDelimiterScanner destructor */
+CDPDelimiterScanner::~CDPDelimiterScanner()
+{}
+
+/*****************************************************************************/
+
+/* Scan Methods */
+
+/**
+  * @brief  Find starting and ending delimiters in a raw chip stream, at any
+  * chip position and for both signal polarities. Delimiters are matched at
+  * all the 64 positions of a chips word at once: each pattern chip is
+  * compared with the word shifted by the chip index and the results are
+  * anded, so a set bit remains at each position where all of them match.
+  * @param  chips Pointer to packed chips (LSB-first, as encode() output).
+  * @param  num_chips Number of chips of the stream.
+  * @param  start_chip Chip position to start looking from.
+  * @param  delimiters Pointer to array to store found delimiters.
+  * @param  delimiters_len Number of elements of the delimiters array.
+  * @return Number of delimiters found (the scan stops if array gets full,
+  * and can continue from the chip after the last delimiter found).
+  */
+size_t CDPDelimiterScanner::find_delimiters(const uint8_t* chips,
+        const uint64_t num_chips, const uint64_t start_chip,
+        cdp_delimiter_t* delimiters, const size_t delimiters_len)
+{
+    const uint64_t num_bytes = (num_chips + 7) / 8;
+    size_t num_found = 0;
+
+    if(num_chips < DELIMITER_CHIPS)
+        return 0;
+
+    for(uint64_t byte_n = (start_chip / 64) * 8; byte_n < num_bytes;
+            byte_n += 8)
+    {
+        const uint64_t word_chip = byte_n * 8;
+        uint64_t low = LOAD_CHIPS(chips, num_bytes, byte_n);
+        uint64_t high = LOAD_CHIPS(chips, num_bytes, byte_n + 8);
+        uint64_t sd_high = ~0ULL;
+        uint64_t sd_low = ~0ULL;
+        uint64_t ed_high = ~0ULL;
+        uint64_t ed_low = ~0ULL;
+        uint64_t ed_data = ~0ULL;
+        uint64_t valid = ~0ULL;
+        uint64_t last_shifted = 0;
+
+        // Match all the pattern chips (for both polarities)
+        for(uint8_t k = 0; k < DELIMITER_CHIPS; k++)
+        {
+            uint64_t shifted = low;
+            if(k > 0)
+                shifted = (low >> k) | (high << (64 - k));
+            if((this->sd_pattern >> k) & 0x01)
+            {
+                sd_high = sd_high & shifted;
+                sd_low = sd_low & ~shifted;
+            }
+            else
+            {
+                sd_high = sd_high & ~shifted;
+                sd_low = sd_low & shifted;
+            }
+            if(k >= ED_MATCH_CHIPS)
+            {
+                if(k & 0x01)
+                    ed_data = ed_data & (shifted ^ last_shifted);
+                last_shifted = shifted;
+                continue;
+            }
+            if((this->ed_pattern >> k) & 0x01)
+            {
+                ed_high = ed_high & shifted;
+                ed_low = ed_low & ~shifted;
+            }
+            else
+            {
+                ed_high = ed_high & ~shifted;
+                ed_low = ed_low & shifted;
+            }
+        }
+
+        // Discard positions before start and delimiters past the end
+        if(word_chip < start_chip)
+            valid = valid & (~0ULL << (start_chip - word_chip));
+        if(word_chip + 64 + DELIMITER_CHIPS > num_chips + 1)
+        {
+            uint64_t last = num_chips - DELIMITER_CHIPS + 1;
+            if(last <= word_chip)
+                valid = 0;
+            else if(last - word_chip < 64)
+                valid = valid & ((1ULL << (last - word_chip)) - 1);
+        }
+        sd_high = sd_high & valid;
+        sd_low = sd_low & valid;
+        ed_high = ed_high & ed_data & valid;
+        ed_low = ed_low & ed_data & valid;
+
+        // Output found delimiters in stream order
+        uint64_t found = sd_high | sd_low | ed_high | ed_low;
+        while(found != 0)
+        {
+            uint8_t n = ctz64(found);
+            uint64_t bit = 1ULL << n;
+            cdp_delimiter_t* delimiter;
+
+            if(num_found >= delimiters_len)
+                return num_found;
+            delimiter = &(delimiters[num_found]);
+
+            delimiter->chip = word_chip + n;
+            delimiter->type = ((sd_high | sd_low) & bit) ? DELIMITER_TYPE_SD :
+                    DELIMITER_TYPE_ED;
+            delimiter->level = ((sd_high | ed_high) & bit) ? LOGIC_LEVEL_HIGH :
+                    LOGIC_LEVEL_LOW;
+            delimiter->ed_bits = 0x00;
+            if(delimiter->type == DELIMITER_TYPE_ED)
+            {
+                // Decode I and E bits (level after JK1JK1 is the initial)
+                uint8_t level_i = GET_CHIP(chips, delimiter->chip + 13);
+                uint8_t level_e = GET_CHIP(chips, delimiter->chip + 15);
+                if(level_i != delimiter->level)
+                    delimiter->ed_bits |= DELIMITER_ED_I_BIT;
+                if(level_e != level_i)
+                    delimiter->ed_bits |= DELIMITER_ED_E_BIT;
+            }
+            num_found = num_found + 1;
+            found = found & (found - 1);
+        }
+    }
+
+    return num_found;
+}
+
+/**
+  * @brief  Find frames (starting delimiter followed by an ending delimiter)
+  * in a raw chip stream. A starting delimiter without ending delimiter
+  * before the next starting delimiter is discarded, and ending delimiters
+  * out of the symbols alignment of the frame are ignored.
+  * @param  chips Pointer to packed chips (LSB-first, as encode() output).
+  * @param  num_chips Number of chips of the stream.
+  * @param  frames Pointer to array to store found frames boundaries.
+  * @param  frames_len Number of elements of the frames array.
+  * @return Number of frames found.
+  */
+size_t CDPDelimiterScanner::find_frames(const uint8_t* chips,
+        const uint64_t num_chips, cdp_frame_bounds_t* frames,
+        const size_t frames_len)
+{
+    return this->find_frames(chips, num_chips, 0, frames, frames_len);
+}
+
+/**
+  * @brief  Find frames (starting delimiter followed by an ending delimiter)
+  * in a raw chip stream from a chip position, i.e. to continue the search
+  * from the end of the last frame found.
+  * @param  chips Pointer to packed chips (LSB-first, as encode() output).
+  * @param  num_chips Number of chips of the stream.
+  * @param  start_chip Chip position to start looking from.
+  * @param  frames Pointer to array to store found frames boundaries.
+  * @param  frames_len Number of elements of the frames array.
+  * @return Number of frames found.
+  */
+size_t CDPDelimiterScanner::find_frames(const uint8_t* chips,
+        const uint64_t num_chips, const uint64_t start_chip,
+        cdp_frame_bounds_t* frames, const size_t frames_len)
+{
+    cdp_delimiter_t delimiters[FRAMES_SCAN_BUFFER_SIZE];
+    uint64_t next_chip = start_chip;
+    size_t num_frames = 0;
+    bool in_frame = false;
+
+    while(num_frames < frames_len)
+    {
+        size_t num_delimiters = this->find_delimiters(chips, num_chips,
+                next_chip, delimiters, FRAMES_SCAN_BUFFER_SIZE);
+        if(num_delimiters == 0)
+            break;
+
+        for(size_t i = 0; (i < num_delimiters) && (num_frames < frames_len);
+                i++)
+        {
+            if(delimiters[i].type == DELIMITER_TYPE_SD)
+            {
+                frames[num_frames].start_chip = delimiters[i].chip;
+                frames[num_frames].level = delimiters[i].level;
+                in_frame = true;
+            }
+            else if(in_frame && (((delimiters[i].chip -
+                    frames[num_frames].start_chip) & 0x01) == 0))
+            {
+                frames[num_frames].end_chip = delimiters[i].chip +
+                        DELIMITER_CHIPS;
+                frames[num_frames].ed_bits = delimiters[i].ed_bits;
+                num_frames = num_frames + 1;
+                in_frame = false;
+            }
+        }
+        next_chip = delimiters[num_delimiters - 1].chip + 1;
+    }
+
+    return num_frames;
+}
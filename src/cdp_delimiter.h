@@ -0,0 +1,119 @@
+/**
+ * @file    cdp_delimiter.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) starting and ending delimiters scanner, that
+ * finds frame boundaries directly in raw encoded chip streams (any
+ * polarity and chip alignment) without decoding the frames data.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_DELIMITER_H_
+#define CDP_DELIMITER_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Starting delimiter (JK0JK000) and ending delimiter (JK1JK1IE) symbols
+// (data bits, with J as 0 and K as 1, and J/K flags bitmap)
+#define DELIMITER_SD_DATA 0x12
+#define DELIMITER_SD_JK   0x1B
+#define DELIMITER_ED_DATA 0x36
+#define DELIMITER_ED_JK   0x1B
+
+// Ending delimiter I (intermediate frame) and E (error detected) bits
+#define DELIMITER_ED_I_BIT 0x40
+#define DELIMITER_ED_E_BIT 0x80
+
+// Chips of each delimiter
+#define DELIMITER_CHIPS 16
+
+// Delimiter types
+#define DELIMITER_TYPE_SD 0
+#define DELIMITER_TYPE_ED 1
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Delimiter found in a chip stream */
+typedef struct
+{
+    uint64_t chip;      // Position of the first chip of the delimiter
+    uint8_t type;       // DELIMITER_TYPE_SD or DELIMITER_TYPE_ED
+    uint8_t level;      // Signal level before the delimiter (polarity)
+    uint8_t ed_bits;    // I and E bits of ending delimiters
+} cdp_delimiter_t;
+
+/* Frame boundaries found in a chip stream */
+typedef struct
+{
+    uint64_t start_chip;    // Position of the first chip of the SD
+    uint64_t end_chip;      // Position of the chip after the ED
+    uint8_t level;          // Signal level before the SD (and after it)
+    uint8_t ed_bits;        // I and E bits of the ending delimiter
+} cdp_frame_bounds_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPDelimiterScanner
+{
+    public:
+
+        CDPDelimiterScanner();
+        ~CDPDelimiterScanner();
+
+        size_t find_delimiters(const uint8_t* chips, const uint64_t num_chips,
+                const uint64_t start_chip, cdp_delimiter_t* delimiters,
+                const size_t delimiters_len);
+        size_t find_frames(const uint8_t* chips, const uint64_t num_chips,
+                cdp_frame_bounds_t* frames, const size_t frames_len);
+        size_t find_frames(const uint8_t* chips, const uint64_t num_chips,
+                const uint64_t start_chip, cdp_frame_bounds_t* frames,
+                const size_t frames_len);
+
+    private:
+
+        uint16_t sd_pattern;
+        uint16_t ed_pattern;
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_DELIMITER_H_ */
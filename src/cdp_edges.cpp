@@ -0,0 +1,305 @@
+/**
+ * @file    cdp_edges.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) decoder for captures
+ * stored as lists of edge timestamps.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_edges.h"
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Fixed point fractional bits used for chip period values (in ticks)
+#define TIME_FRAC_BITS 16
+
+// Chip period estimation update gain (as right shift of the error)
+#define PERIOD_GAIN_SHIFT 4
+
+// Maximum deviation of the chip period from nominal (as right shift)
+#define MAX_DEVIATION_SHIFT 3
+
+// Longest run of chips between two edges inside a frame (code violation
+// symbols included), longer runs are taken as idle line between frames
+#define MAX_FRAME_RUN_CHIPS 4
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPEdges constructor */
+CDPEdges::CDPEdges()
+{
+    this->setup(1.0, LOGIC_LEVEL_LOW, LOGIC_LEVEL_HIGH, NULL, 0, NULL, NULL);
+}
+
+/* CDPEdges destructor */
+CDPEdges::~CDPEdges()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup the decoder and reset its state.
+  * @param  ticks_per_chip Nominal chip duration in timestamp ticks.
+  * @param  initial_level Line logic level before the first edge (idle).
+  * @param  first_chip_level Logic level of the first chip of each frame. A
+  * frame whose first chip is at the idle level has no edge at its start
+  * (its first edge is the end of that chip), so this level is needed to
+  * align it.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at flush (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Setup result ok (true/false if ticks per chip is invalid).
+  */
+bool CDPEdges::setup(const float ticks_per_chip, const uint8_t initial_level,
+        const uint8_t first_chip_level, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    if(ticks_per_chip < 1.0)
+        return false;
+
+    this->nominal_period = (int64_t)(ticks_per_chip * (1 << TIME_FRAC_BITS));
+    this->initial_level = initial_level;
+    this->first_chip_level = first_chip_level;
+    this->Decoder.setup(data_out, data_out_len, callback, callback_arg);
+    this->reset();
+
+    return true;
+}
+
+/**
+  * @brief  Reset decoder state to the start of a capture.
+  */
+void CDPEdges::reset(void)
+{
+    this->Decoder.reset();
+    this->chip_period = this->nominal_period;
+    this->last_edge_time = 0;
+    this->current_signal_level = this->initial_level;
+    this->started = false;
+    this->error = false;
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Decode a piece of an edges capture given as 32 bits timestamps
+  * (the counter can wrap around between edges). It can be called successive
+  * times with consecutive pieces of the capture. Each edge marks the start
+  * of a chip run, and the first edge of the capture (or the first after an
+  * idle line period) marks the start of a frame, or the end of its first
+  * chip if it is not at the setup first chip level.
+  * @param  edges_in Pointer to edge timestamps.
+  * @param  edges_in_len Number of edge timestamps.
+  * @return Decode result ok (true/false on output overflow).
+  */
+bool CDPEdges::decode(const uint32_t* edges_in, const size_t edges_in_len)
+{
+    size_t i = 0;
+
+    if(this->error)
+        return false;
+
+    if((this->started == false) && (edges_in_len > 0))
+    {
+        this->last_edge_time = edges_in[0];
+        this->current_signal_level = this->current_signal_level ^ 0x01;
+        this->started = true;
+        i = 1;
+        if(this->start_frame() == false)
+            return false;
+    }
+    for(; i < edges_in_len; i++)
+    {
+        uint32_t interval = edges_in[i] - (uint32_t)(this->last_edge_time);
+        this->last_edge_time = edges_in[i];
+        if(this->process_interval(interval) == false)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Decode a piece of an edges capture given as 64 bits timestamps.
+  * It can be called successive times with consecutive pieces of the capture.
+  * @param  edges_in Pointer to edge timestamps.
+  * @param  edges_in_len Number of edge timestamps.
+  * @return Decode result ok (true/false on output overflow).
+  */
+bool CDPEdges::decode(const uint64_t* edges_in, const size_t edges_in_len)
+{
+    size_t i = 0;
+
+    if(this->error)
+        return false;
+
+    if((this->started == false) && (edges_in_len > 0))
+    {
+        this->last_edge_time = edges_in[0];
+        this->current_signal_level = this->current_signal_level ^ 0x01;
+        this->started = true;
+        i = 1;
+        if(this->start_frame() == false)
+            return false;
+    }
+    for(; i < edges_in_len; i++)
+    {
+        uint64_t interval = edges_in[i] - this->last_edge_time;
+        this->last_edge_time = edges_in[i];
+        if(this->process_interval(interval) == false)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  End of capture. The run after the last edge is taken as idle
+  * line (completing the last frame) and decoded bytes pending in the output
+  * array are flushed to the callback.
+  * @return Flush result ok (true/false if some output overflow happened).
+  */
+bool CDPEdges::flush(void)
+{
+    if(this->started)
+    {
+        if(this->Decoder.resync(this->current_signal_level) == false)
+            this->error = true;
+    }
+    return (this->Decoder.flush() && !(this->error));
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get number of decoded bytes currently stored in the output array */
+size_t CDPEdges::get_decoded_len(void)
+{   return this->Decoder.get_decoded_len();   }
+
+/* Get total number of decoded bytes since last reset */
+uint64_t CDPEdges::get_decoded_total(void)
+{   return this->Decoder.get_decoded_total();   }
+
+/* Get current estimated chip duration in ticks */
+float CDPEdges::get_ticks_per_chip(void)
+{   return ((float)this->chip_period / (1 << TIME_FRAC_BITS));   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Start a frame at the current edge. If the level after the edge
+  * is not the first chip level, the frame first chip was the idle level
+  * before the edge, so that chip is pushed to the decoder.
+  * @return Result ok (true/false on output overflow).
+  */
+bool CDPEdges::start_frame(void)
+{
+    if(this->current_signal_level == this->first_chip_level)
+        return true;
+    if(this->Decoder.push_run(this->first_chip_level, 1) == false)
+    {
+        this->error = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+  * @brief  Classify the interval between two edges as a number of chips
+  * (rounding against the adaptive chip period, so 1 or 2 chips are split
+  * by a 1.5 chips threshold), push that run of chips to the decoder and
+  * adapt the chip period estimation. Too long intervals are idle line.
+  * @param  interval Ticks between previous edge and current one.
+  * @return Result ok (true/false on output overflow).
+  */
+bool CDPEdges::process_interval(const uint64_t interval)
+{
+    uint64_t max_interval = 0;
+    int64_t interval_fixed = 0;
+    int64_t max_deviation = this->nominal_period >> MAX_DEVIATION_SHIFT;
+    uint64_t num_chips = 0;
+    bool result = true;
+
+    // Clamp the interval so the fixed point shift can't overflow, any gap
+    // longer than the maximum run is idle line and decodes the same
+    max_interval = (((uint64_t)this->chip_period *
+            (MAX_FRAME_RUN_CHIPS + 1)) >> TIME_FRAC_BITS) + 1;
+    if(interval > max_interval)
+        interval_fixed = (int64_t)(max_interval << TIME_FRAC_BITS);
+    else
+        interval_fixed = (int64_t)(interval << TIME_FRAC_BITS);
+
+    num_chips = (interval_fixed + (this->chip_period / 2)) / this->chip_period;
+    if(num_chips == 0)
+        num_chips = 1;
+
+    // Idle line: end of frame, next edge starts a new one
+    if(num_chips > MAX_FRAME_RUN_CHIPS)
+        result = this->Decoder.resync(this->current_signal_level);
+    else
+    {
+        result = this->Decoder.push_run(this->current_signal_level,
+                (size_t)num_chips);
+
+        // Adapt chip period with the half bit and full bit intervals
+        if(num_chips <= 2)
+        {
+            int64_t period_error = (interval_fixed / (int64_t)num_chips) -
+                    this->chip_period;
+            this->chip_period = this->chip_period +
+                    (period_error / (1 << PERIOD_GAIN_SHIFT));
+            if(this->chip_period > this->nominal_period + max_deviation)
+                this->chip_period = this->nominal_period + max_deviation;
+            if(this->chip_period < this->nominal_period - max_deviation)
+                this->chip_period = this->nominal_period - max_deviation;
+        }
+    }
+    this->current_signal_level = this->current_signal_level ^ 0x01;
+
+    if(result == false)
+        this->error = true;
+    else if(num_chips > MAX_FRAME_RUN_CHIPS)
+        result = this->start_frame();
+    return result;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file    cdp_edges.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) decoder for captures
+ * stored as lists of edge timestamps (run-length form), without expanding
+ * them to samples or chips.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_EDGES_H_
+#define CDP_EDGES_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp_stream.h"
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPEdges
+{
+    public:
+
+        CDPEdges();
+        ~CDPEdges();
+
+        bool setup(const float ticks_per_chip, const uint8_t initial_level,
+                const uint8_t first_chip_level, uint8_t* data_out,
+                const size_t data_out_len, cdp_stream_cb callback,
+                void* callback_arg);
+        void reset(void);
+
+        bool decode(const uint32_t* edges_in, const size_t edges_in_len);
+        bool decode(const uint64_t* edges_in, const size_t edges_in_len);
+        bool flush(void);
+
+        size_t get_decoded_len(void);
+        uint64_t get_decoded_total(void);
+        float get_ticks_per_chip(void);
+
+    private:
+
+        CDPStreamDecoder Decoder;
+
+        int64_t nominal_period;
+        int64_t chip_period;
+        uint64_t last_edge_time;
+        uint8_t initial_level;
+        uint8_t first_chip_level;
+        uint8_t current_signal_level;
+        bool started;
+        bool error;
+
+        bool start_frame(void);
+        bool process_interval(const uint64_t interval);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_EDGES_H_ */
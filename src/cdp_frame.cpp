@@ -0,0 +1,293 @@
+/**
+ * @file    cdp_frame.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) frames builder and parser.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_frame.h"
+#include "cdp_delimiter.h"
+#include "cdp_crc.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPFrame constructor */
+CDPFrame::CDPFrame()
+{}
+
+/* CDPFrame destructor */
+CDPFrame::~CDPFrame()
+{}
+
+/*****************************************************************************/
+
+/* Build Methods */
+
+/**
+  * @brief  Build and encode a frame (SD, AC, FC, DA, SA, payload, FCS, ED
+  * and FS). The FCS (CRC-32 of FC, DA, SA and payload) is computed block
+  * by block just before encoding each block, so the payload is read once
+  * from memory. ED I/E bits and FS are sent cleared.
+  * @param  ac Access control field.
+  * @param  fc Frame control field.
+  * @param  da Pointer to destination address (FRAME_ADDR_LEN bytes).
+  * @param  sa Pointer to source address (FRAME_ADDR_LEN bytes).
+  * @param  payload Pointer to frame payload (information field).
+  * @param  payload_len Number of bytes of the payload.
+  * @param  data_out Pointer to output data array to store the encoded frame.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (get_encoded_len() bytes needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the frame.
+  * @return Build result ok (true/false).
+  */
+bool CDPFrame::build(const uint8_t ac, const uint8_t fc, const uint8_t* da,
+        const uint8_t* sa, const uint8_t* payload, const size_t payload_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    uint8_t header[FRAME_HEADER_LEN];
+    uint8_t trailer[CRC32_FCS_LEN];
+    uint8_t symbol = 0;
+    uint8_t jk = 0;
+    uint32_t crc = CRC32_INIT;
+    uint32_t fcs = 0;
+
+    // Check if the encoded frame doesn't fit in output array
+    if(get_encoded_len(payload_len) > data_out_len)
+        return false;
+
+    // Starting delimiter
+    symbol = DELIMITER_SD_DATA;
+    jk = DELIMITER_SD_JK;
+    this->Cdp.encode_symbols(&symbol, &jk, 1, data_out, 2,
+            current_signal_level);
+    data_out = data_out + 2;
+
+    // Header (FCS covers it from FC)
+    header[0] = ac;
+    header[1] = fc;
+    memcpy(header + 2, da, FRAME_ADDR_LEN);
+    memcpy(header + 2 + FRAME_ADDR_LEN, sa, FRAME_ADDR_LEN);
+    crc = crc32_update(crc, header + 1, FRAME_HEADER_LEN - 1);
+    this->Cdp.encode(header, FRAME_HEADER_LEN, data_out, FRAME_HEADER_LEN*2,
+            current_signal_level);
+    data_out = data_out + FRAME_HEADER_LEN*2;
+
+    // Payload blocks
+    for(size_t i = 0; i < payload_len; i += FRAME_BLOCK_SIZE)
+    {
+        size_t block_len = payload_len - i;
+        if(block_len > FRAME_BLOCK_SIZE)
+            block_len = FRAME_BLOCK_SIZE;
+        crc = crc32_update(crc, payload + i, block_len);
+        this->Cdp.encode(payload + i, block_len, data_out, block_len*2,
+                current_signal_level);
+        data_out = data_out + block_len*2;
+    }
+
+    // Frame check sequence
+    fcs = crc32_final(crc);
+    trailer[0] = (uint8_t)(fcs & 0xFF);
+    trailer[1] = (uint8_t)((fcs >> 8) & 0xFF);
+    trailer[2] = (uint8_t)((fcs >> 16) & 0xFF);
+    trailer[3] = (uint8_t)((fcs >> 24) & 0xFF);
+    this->Cdp.encode(trailer, CRC32_FCS_LEN, data_out, CRC32_FCS_LEN*2,
+            current_signal_level);
+    data_out = data_out + CRC32_FCS_LEN*2;
+
+    // Ending delimiter and frame status
+    symbol = DELIMITER_ED_DATA;
+    jk = DELIMITER_ED_JK;
+    this->Cdp.encode_symbols(&symbol, &jk, 1, data_out, 2,
+            current_signal_level);
+    data_out = data_out + 2;
+    symbol = 0x00;
+    this->Cdp.encode(&symbol, 1, data_out, 2, current_signal_level);
+
+    return true;
+}
+
+/**
+  * @brief  Get the number of bytes of an encoded frame.
+  * @param  payload_len Number of bytes of the frame payload.
+  * @return Number of bytes of the encoded frame.
+  */
+size_t CDPFrame::get_encoded_len(const size_t payload_len)
+{
+    return (FRAME_OVERHEAD_LEN + payload_len) * 2;
+}
+
+/*****************************************************************************/
+
+/* Parse Methods */
+
+/**
+  * @brief  Parse a decoded frame (from AC to FCS, without delimiters),
+  * giving the offsets of its fields from the start of the frame. No data
+  * is copied.
+  * @param  frame Pointer to the decoded frame.
+  * @param  frame_len Number of bytes of the frame.
+  * @param  view Pointer to frame view to store the fields offsets.
+  * @return Parse result ok (true/false, false if the frame is too short for
+  * its fields; the FCS check result is given in the view).
+  */
+bool CDPFrame::parse(const uint8_t* frame, const size_t frame_len,
+        cdp_frame_view_t* view)
+{
+    return this->parse(frame, 0, frame_len, view);
+}
+
+/**
+  * @brief  Parse a decoded frame (from AC to FCS, without delimiters) that
+  * is inside a larger buffer, giving the offsets of its fields from the
+  * start of the buffer. No data is copied.
+  * @param  data Pointer to the buffer that holds the frame.
+  * @param  frame_offset Offset of the frame (AC) in the buffer.
+  * @param  frame_len Number of bytes of the frame.
+  * @param  view Pointer to frame view to store the fields offsets.
+  * @return Parse result ok (true/false, false if the frame is too short for
+  * its fields; the FCS check result is given in the view).
+  */
+bool CDPFrame::parse(const uint8_t* data, const size_t frame_offset,
+        const size_t frame_len, cdp_frame_view_t* view)
+{
+    view->ed_bits = 0x00;
+    view->fs = 0x00;
+    return this->parse_view(data, frame_offset, frame_len, view);
+}
+
+/**
+  * @brief  Parse all the frames of a decoded capture (decode_symbols()
+  * output), finding them by their J/K delimiters. Views offsets are given
+  * from the start of the capture buffer, so no data is copied. Bytes
+  * without J/K symbols outside frames are skipped 16 at once.
+  * @param  data Pointer to decoded capture data.
+  * @param  jk Pointer to decoded capture J/K flags.
+  * @param  data_len Number of bytes of the decoded capture.
+  * @param  views Pointer to array to store the frames views.
+  * @param  views_len Number of elements of the views array.
+  * @return Number of frames parsed (frames too short for their fields and
+  * starting delimiters without ending delimiter are skipped).
+  */
+size_t CDPFrame::parse_batch(const uint8_t* data, const uint8_t* jk,
+        const size_t data_len, cdp_frame_view_t* views,
+        const size_t views_len)
+{
+    size_t num_views = 0;
+    size_t start = 0;
+    bool in_frame = false;
+    size_t i = 0;
+
+    while((i < data_len) && (num_views < views_len))
+    {
+        // Skip data bytes (no J/K symbols)
+        i = i + idle_bytes_len(jk + i, data_len - i, LOGIC_LEVEL_LOW);
+        if(i >= data_len)
+            break;
+
+        if((data[i] == DELIMITER_SD_DATA) && (jk[i] == DELIMITER_SD_JK))
+        {
+            start = i + 1;
+            in_frame = true;
+        }
+        else if(in_frame && (jk[i] == DELIMITER_ED_JK) &&
+                ((data[i] & ~(DELIMITER_ED_I_BIT | DELIMITER_ED_E_BIT)) ==
+                DELIMITER_ED_DATA))
+        {
+            cdp_frame_view_t* view = &(views[num_views]);
+            view->ed_bits = data[i] & (DELIMITER_ED_I_BIT|DELIMITER_ED_E_BIT);
+            view->fs = 0x00;
+            if((i + 1 < data_len) && (jk[i + 1] == 0x00))
+                view->fs = data[i + 1];
+            if(this->parse_view(data, start, i - start, view))
+                num_views = num_views + 1;
+            in_frame = false;
+        }
+        else
+            in_frame = false;
+        i = i + 1;
+    }
+
+    return num_views;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Get the fields offsets of a frame, and check its FCS.
+  * @param  data Pointer to the buffer that holds the frame.
+  * @param  frame_offset Offset of the frame (AC) in the buffer.
+  * @param  frame_len Number of bytes of the frame (AC to FCS).
+  * @param  view Pointer to frame view to store the fields offsets.
+  * @return Parse result ok (true/false).
+  */
+bool CDPFrame::parse_view(const uint8_t* data, const size_t frame_offset,
+        const size_t frame_len, cdp_frame_view_t* view)
+{
+    const uint8_t* frame = data + frame_offset;
+    uint8_t ri_len = 0;
+
+    if(frame_len < FRAME_MIN_LEN)
+        return false;
+
+    // Routing information, if source address indicates it
+    if(frame[2 + FRAME_ADDR_LEN] & FRAME_SA_RII_BIT)
+    {
+        if(frame_len < FRAME_MIN_LEN + 1)
+            return false;
+        ri_len = frame[FRAME_HEADER_LEN] & FRAME_RI_LEN_MASK;
+        if((ri_len < 2) || (frame_len < (size_t)(FRAME_MIN_LEN + ri_len)))
+            return false;
+    }
+
+    view->ac = frame_offset;
+    view->fc = view->ac + 1;
+    view->da = view->ac + 2;
+    view->sa = view->da + FRAME_ADDR_LEN;
+    view->ri = view->ac + FRAME_HEADER_LEN;
+    view->ri_len = ri_len;
+    view->payload = view->ri + ri_len;
+    view->fcs = view->ac + frame_len - CRC32_FCS_LEN;
+    view->frame_len = frame_len;
+    view->payload_len = view->fcs - view->payload;
+    view->fcs_ok = (crc32_update(CRC32_INIT, frame + 1, frame_len - 1) ==
+            CRC32_RESIDUE);
+
+    return true;
+}
+
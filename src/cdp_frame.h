@@ -0,0 +1,145 @@
+/**
+ * @file    cdp_frame.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) frames builder, that encodes the frame fields
+ * and computes its frame check sequence in a single pass over the data,
+ * and frames parser, that gives views (fields offsets and lengths) into
+ * decoded buffers without copying the frames.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_FRAME_H_
+#define CDP_FRAME_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+#include "cdp_crc.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Bytes of the frame addresses fields
+#define FRAME_ADDR_LEN 6
+
+// Bytes of the frame fields before the payload (AC, FC, DA and SA)
+#define FRAME_HEADER_LEN (2 + 2*FRAME_ADDR_LEN)
+
+// Bytes of a frame without payload (SD, header, FCS, ED and FS)
+#define FRAME_OVERHEAD_LEN (1 + FRAME_HEADER_LEN + CRC32_FCS_LEN + 1 + 1)
+
+// Offsets of the frame fields (from the SD)
+#define FRAME_AC_OFFSET      1
+#define FRAME_FC_OFFSET      2
+#define FRAME_DA_OFFSET      3
+#define FRAME_SA_OFFSET      (FRAME_DA_OFFSET + FRAME_ADDR_LEN)
+#define FRAME_PAYLOAD_OFFSET (1 + FRAME_HEADER_LEN)
+
+// Bytes of a token (SD, AC and ED)
+#define FRAME_TOKEN_LEN 3
+
+// Bytes of the shortest frame between delimiters (header and FCS)
+#define FRAME_MIN_LEN (FRAME_HEADER_LEN + CRC32_FCS_LEN)
+
+// Source address routing information indicator bit, and routing control
+// field length bits (in the first byte of SA and RI)
+#define FRAME_SA_RII_BIT 0x80
+#define FRAME_RI_LEN_MASK 0x1F
+
+// Payload bytes encoded on each step of the frame build (the CRC and the
+// encoder work over the same block while it is cached)
+#define FRAME_BLOCK_SIZE 512
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Frame view (fields offsets into the parsed buffer, and lengths) */
+typedef struct
+{
+    size_t ac;              // Access control offset (start of the frame)
+    size_t fc;              // Frame control offset
+    size_t da;              // Destination address offset
+    size_t sa;              // Source address offset
+    size_t ri;              // Routing information offset
+    size_t payload;         // Payload (information field) offset
+    size_t fcs;             // Frame check sequence offset
+    size_t frame_len;       // Bytes from AC to FCS (both included)
+    size_t payload_len;     // Bytes of the payload
+    uint8_t ri_len;         // Bytes of the routing information (0 if none)
+    uint8_t ed_bits;        // I and E bits of the ending delimiter
+    uint8_t fs;             // Frame status (0 if not captured)
+    bool fcs_ok;            // Frame check sequence result
+} cdp_frame_view_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPFrame
+{
+    public:
+
+        CDPFrame();
+        ~CDPFrame();
+
+        bool build(const uint8_t ac, const uint8_t fc, const uint8_t* da,
+                const uint8_t* sa, const uint8_t* payload,
+                const size_t payload_len, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+
+        bool parse(const uint8_t* frame, const size_t frame_len,
+                cdp_frame_view_t* view);
+        bool parse(const uint8_t* data, const size_t frame_offset,
+                const size_t frame_len, cdp_frame_view_t* view);
+        size_t parse_batch(const uint8_t* data, const uint8_t* jk,
+                const size_t data_len, cdp_frame_view_t* views,
+                const size_t views_len);
+
+        static size_t get_encoded_len(const size_t payload_len);
+
+    private:
+
+        CDP Cdp;
+
+        bool parse_view(const uint8_t* data, const size_t frame_offset,
+                const size_t frame_len, cdp_frame_view_t* view);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_FRAME_H_ */
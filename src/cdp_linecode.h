@@ -0,0 +1,297 @@
+/**
+ * @file    cdp_linecode.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Family of two chips per bit line codes (Differential Manchester,
+ * Manchester in IEEE 802.3 and G.E. Thomas conventions, biphase space/FM0
+ * and biphase mark/FM1), as a template over compile time policies (code,
+ * transition convention, bit order and initial level), so every variant
+ * gets the same word at once encode/decode kernels without runtime
+ * branches.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_LINECODE_H_
+#define CDP_LINECODE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+#include "cdp_bits.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Line codes:
+//   Differential Manchester: middle transition always, transition at start
+//     of 0 bits (normal) or of 1 bits (inverted).
+//   Manchester: 0 bits as "10" chips and 1 bits as "01" chips (normal,
+//     IEEE 802.3) or the opposite (inverted, G.E. Thomas).
+//   Biphase: transition at start always, middle transition for 0 bits
+//     (normal, biphase space/FM0) or for 1 bits (inverted, biphase
+//     mark/FM1).
+#define LINE_CODE_DIFF_MANCHESTER 0
+#define LINE_CODE_MANCHESTER      1
+#define LINE_CODE_BIPHASE         2
+
+// Transition conventions
+#define LINE_CONVENTION_NORMAL   0
+#define LINE_CONVENTION_INVERTED 1
+
+// Data bits order on the line (chips are packed in the same order)
+#define LINE_BIT_ORDER_LSB_FIRST 0
+#define LINE_BIT_ORDER_MSB_FIRST 1
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+template <uint8_t CODE, uint8_t CONVENTION, uint8_t BIT_ORDER,
+        uint8_t INITIAL_LEVEL>
+class CDPLineCode
+{
+    static_assert(CODE <= LINE_CODE_BIPHASE, "Unknown line code");
+    static_assert(CONVENTION <= LINE_CONVENTION_INVERTED,
+            "Unknown transition convention");
+    static_assert(BIT_ORDER <= LINE_BIT_ORDER_MSB_FIRST,
+            "Unknown bit order");
+    static_assert(INITIAL_LEVEL <= LOGIC_LEVEL_HIGH, "Unknown level");
+
+    public:
+
+        CDPLineCode()
+        {}
+
+        /**
+          * @brief  Encode input data from the initial signal level.
+          * @param  data_in Pointer to input data to be encode.
+          * @param  data_in_len Number of bytes to encode from input data.
+          * @param  data_out Pointer to output data array to store the
+          * encoded data.
+          * @param  data_out_len Number of bytes that can be stored in the
+          * output data array.
+          * @return Encode result ok (true/false).
+          */
+        bool encode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len)
+        {
+            uint8_t current_signal_level = INITIAL_LEVEL;
+            return this->encode(data_in, data_in_len, data_out, data_out_len,
+                    &current_signal_level);
+        }
+
+        /**
+          * @brief  Encode input data continuing from a given signal level,
+          * 32 bits at once.
+          * @param  data_in Pointer to input data to be encode.
+          * @param  data_in_len Number of bytes to encode from input data.
+          * @param  data_out Pointer to output data array to store the
+          * encoded data.
+          * @param  data_out_len Number of bytes that can be stored in the
+          * output data array.
+          * @param  current_signal_level Pointer to current logic signal
+          * level value (LOW or HIGH), updated to the level at the end of
+          * the data.
+          * @return Encode result ok (true/false).
+          */
+        bool encode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level)
+        {
+            if(data_in_len*2 > data_out_len)
+                return false;
+
+            for(size_t i = 0; i < data_in_len; i = i + 4)
+            {
+                uint8_t len = (data_in_len - i < 4) ?
+                        (uint8_t)(data_in_len - i) : 4;
+                uint64_t word = load_le64_len(data_in + i, len);
+                if(BIT_ORDER == LINE_BIT_ORDER_MSB_FIRST)
+                    word = reverse_bits8x8(word);
+                word = ENCODE_BITS((uint32_t)word, len*8,
+                        current_signal_level);
+                if(BIT_ORDER == LINE_BIT_ORDER_MSB_FIRST)
+                    word = reverse_bits8x8(word);
+                store_le64_len(data_out + i*2, word, len*2);
+            }
+
+            return true;
+        }
+
+        /**
+          * @brief  Decode input data from the initial signal level.
+          * @param  data_in Pointer to encoded input data to be decoded.
+          * @param  data_in_len Number of bytes to decode from input data.
+          * @param  data_out Pointer to output data array to store the
+          * decoded data.
+          * @param  data_out_len Number of bytes that can be stored in the
+          * output data array.
+          * @return Decode result ok (true/false).
+          */
+        bool decode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len)
+        {
+            uint8_t current_signal_level = INITIAL_LEVEL;
+            return this->decode(data_in, data_in_len, data_out, data_out_len,
+                    &current_signal_level);
+        }
+
+        /**
+          * @brief  Decode input data continuing from a given signal level,
+          * 32 bits at once (from the second chip of each bit).
+          * @param  data_in Pointer to encoded input data to be decoded.
+          * @param  data_in_len Number of bytes to decode from input data
+          * (even).
+          * @param  data_out Pointer to output data array to store the
+          * decoded data.
+          * @param  data_out_len Number of bytes that can be stored in the
+          * output data array.
+          * @param  current_signal_level Pointer to current logic signal
+          * level value (LOW or HIGH), updated to the level at the end of
+          * the data.
+          * @return Decode result ok (true/false).
+          */
+        bool decode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level)
+        {
+            if((data_out_len*2 < data_in_len) || (data_in_len % 2 != 0))
+                return false;
+
+            for(size_t i = 0; i < data_in_len; i = i + 8)
+            {
+                uint8_t len = (data_in_len - i < 8) ?
+                        (uint8_t)(data_in_len - i) : 8;
+                uint64_t word = load_le64_len(data_in + i, len);
+                if(BIT_ORDER == LINE_BIT_ORDER_MSB_FIRST)
+                    word = reverse_bits8x8(word);
+                word = DECODE_CHIPS(word, len*4, current_signal_level);
+                if(BIT_ORDER == LINE_BIT_ORDER_MSB_FIRST)
+                    word = reverse_bits8x8(word);
+                store_le64_len(data_out + i/2, word, len/2);
+            }
+
+            return true;
+        }
+
+        /**
+          * @brief  Encode up to 32 bits into their chips at once. The
+          * signal level after each bit (its second chip) is the bit itself
+          * for Manchester and the prefix xor of the bits with the current
+          * level for the differential codes (inverted bits for the
+          * inverted convention). The first chip is the inverted level
+          * after the bit (middle transition always) or before the bit
+          * (transition at start always, biphase).
+          * @param  data Data bits (LSb first).
+          * @param  num_bits Number of bits (1 to 32).
+          * @param  current_signal_level Pointer to current logic signal
+          * level.
+          * @return Encoded chips (LSB-first, 2 chips for each bit).
+          */
+        static inline uint64_t ENCODE_BITS(const uint32_t data,
+                const uint8_t num_bits, uint8_t* current_signal_level)
+        {
+            uint32_t levels = data;
+            uint32_t first_chips = 0;
+
+            if(CONVENTION == LINE_CONVENTION_INVERTED)
+                levels = ~levels;
+            if(CODE != LINE_CODE_MANCHESTER)
+            {
+                levels = prefix_xor32(levels);
+                if(*current_signal_level)
+                    levels = ~levels;
+            }
+            if(CODE == LINE_CODE_BIPHASE)
+                first_chips = ~((levels << 1) | *current_signal_level);
+            else
+                first_chips = ~levels;
+            *current_signal_level = (uint8_t)((levels >> (num_bits - 1)) &
+                    0x01);
+
+            return (expand_even64(first_chips) |
+                    (expand_even64(levels) << 1));
+        }
+
+        /**
+          * @brief  Decode up to 32 bits from their chips at once (inverse
+          * of ENCODE_BITS() from the second chips).
+          * @param  chips Encoded chips (LSB-first, 2 chips for each bit).
+          * @param  num_bits Number of bits (1 to 32).
+          * @param  current_signal_level Pointer to current logic signal
+          * level.
+          * @return Data bits (LSb first).
+          */
+        static inline uint32_t DECODE_CHIPS(const uint64_t chips,
+                const uint8_t num_bits, uint8_t* current_signal_level)
+        {
+            uint32_t levels = compress_even64(chips >> 1);
+            uint32_t data = levels;
+
+            if(CODE != LINE_CODE_MANCHESTER)
+                data = levels ^ ((levels << 1) | *current_signal_level);
+            if(CONVENTION == LINE_CONVENTION_INVERTED)
+                data = ~data;
+            *current_signal_level = (uint8_t)((levels >> (num_bits - 1)) &
+                    0x01);
+
+            return data;
+        }
+};
+
+/*****************************************************************************/
+
+/* Line Codes */
+
+// IEEE 802.5 Differential Manchester (same output as CDP)
+typedef CDPLineCode<LINE_CODE_DIFF_MANCHESTER, LINE_CONVENTION_NORMAL,
+        LINE_BIT_ORDER_LSB_FIRST, INITIAL_SIGNAL_LEVEL> CDPDiffManchester;
+
+// IEEE 802.3 and G.E. Thomas Manchester
+typedef CDPLineCode<LINE_CODE_MANCHESTER, LINE_CONVENTION_NORMAL,
+        LINE_BIT_ORDER_LSB_FIRST, INITIAL_SIGNAL_LEVEL> CDPManchesterIEEE;
+typedef CDPLineCode<LINE_CODE_MANCHESTER, LINE_CONVENTION_INVERTED,
+        LINE_BIT_ORDER_LSB_FIRST, INITIAL_SIGNAL_LEVEL> CDPManchesterThomas;
+
+// Biphase space (FM0) and biphase mark (FM1)
+typedef CDPLineCode<LINE_CODE_BIPHASE, LINE_CONVENTION_NORMAL,
+        LINE_BIT_ORDER_LSB_FIRST, INITIAL_SIGNAL_LEVEL> CDPBiphaseSpace;
+typedef CDPLineCode<LINE_CODE_BIPHASE, LINE_CONVENTION_INVERTED,
+        LINE_BIT_ORDER_LSB_FIRST, INITIAL_SIGNAL_LEVEL> CDPBiphaseMark;
+
+/*****************************************************************************/
+
+#endif /* CDP_LINECODE_H_ */
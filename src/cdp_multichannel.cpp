@@ -0,0 +1,244 @@
+/**
+ * @file    cdp_multichannel.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Bit-sliced Conditional DePhase encoder of 8 or 16 channels.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_multichannel.h"
+#include "cdp_bits.h"
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Bit-slice two 8x8 bits matrices at once (a byte of 8 channels
+  * each): slice i gets bit i of every byte of both words, first word bytes
+  * in the low byte of the slice. With SSE2, the two words are the two
+  * halves of a register and each slice is the byte MSbs mask, shifting the
+  * bytes left one bit for the next slice (scalar transposes otherwise).
+  * @param  low Bytes for the low byte of the slices (byte c for bit c).
+  * @param  high Bytes for the high byte of the slices.
+  * @param  slices Pointer to store the 8 slices (bit i in slices[i]).
+  */
+static inline void SLICE_PAIR(const uint64_t low, const uint64_t high,
+        uint16_t* slices)
+{
+    #if defined(__SSE2__)
+        __m128i x = _mm_set_epi64x((long long)high, (long long)low);
+        for(int8_t i = 7; i >= 0; i--)
+        {
+            slices[i] = (uint16_t)_mm_movemask_epi8(x);
+            x = _mm_slli_epi64(x, 1);
+        }
+    #else
+        uint64_t t_low = transpose_bits8x8(low);
+        uint64_t t_high = transpose_bits8x8(high);
+        for(uint8_t i = 0; i < 8; i++)
+        {
+            slices[i] = (uint16_t)(((t_low >> (8*i)) & 0xFF) |
+                    (((t_high >> (8*i)) & 0xFF) << 8));
+        }
+    #endif
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPMultiChannel constructor */
+CDPMultiChannel::CDPMultiChannel()
+{
+    this->setup(MULTICHANNEL_8_CHANNELS);
+}
+
+/* CDPMultiChannel destructor */
+CDPMultiChannel::~CDPMultiChannel()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup the number of channels and reset the channels signal
+  * levels.
+  * @param  num_channels Number of channels (MULTICHANNEL_8_CHANNELS or
+  * MULTICHANNEL_16_CHANNELS).
+  * @return Setup result ok (true/false).
+  */
+bool CDPMultiChannel::setup(const uint8_t num_channels)
+{
+    if((num_channels != MULTICHANNEL_8_CHANNELS) &&
+       (num_channels != MULTICHANNEL_16_CHANNELS))
+        return false;
+    this->num_channels = num_channels;
+    this->reset();
+    return true;
+}
+
+/**
+  * @brief  Reset the signal level of all channels to INITIAL_SIGNAL_LEVEL.
+  */
+void CDPMultiChannel::reset(void)
+{
+    this->levels = (INITIAL_SIGNAL_LEVEL == LOGIC_LEVEL_HIGH) ? 0xFFFF : 0;
+    if(this->num_channels == MULTICHANNEL_8_CHANNELS)
+        this->levels = this->levels & 0x00FF;
+}
+
+/*****************************************************************************/
+
+/* Encode Methods */
+
+/**
+  * @brief  Encode the data of every channel into transposed chip words:
+  * output byte (8 channels) or little-endian 16 bits word (16 channels) k
+  * holds chip k of each channel (bit c for channel c), same chips as
+  * CDP::encode() of each channel data. 8 bytes of each channel are loaded,
+  * the 8x8 bytes matrices are transposed to get each byte position of all
+  * the channels in a word, and those words are bit-sliced, so the encode
+  * works on a slice of all the channels at once (the levels after each bit
+  * are the xor of the slices, and the chips are "not(levels), levels").
+  * Consecutive calls continue the stream of each channel.
+  * @param  data_in Pointer to the data of each channel.
+  * @param  data_in_len Number of bytes to encode of each channel.
+  * @param  data_out Pointer to output data array to store the chip words.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len*16 chip words).
+  * @return Encode result ok (true/false).
+  */
+bool CDPMultiChannel::encode(const uint8_t* const* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len)
+{
+    const uint8_t word_len = this->num_channels / 8;
+    uint64_t low[8];
+    uint64_t high[8];
+    uint16_t slices[16];
+
+    if(data_in_len*16*word_len > data_out_len)
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = (data_in_len - i < 8) ? (uint8_t)(data_in_len - i) : 8;
+
+        // Each byte position of all channels in a word
+        for(uint8_t c = 0; c < 8; c++)
+        {
+            low[c] = load_le64_len(data_in[c] + i, len);
+            if(this->num_channels == MULTICHANNEL_16_CHANNELS)
+                high[c] = load_le64_len(data_in[c + 8] + i, len);
+        }
+        transpose_bytes8x8(low);
+        if(this->num_channels == MULTICHANNEL_16_CHANNELS)
+            transpose_bytes8x8(high);
+
+        // Slice and encode them
+        for(uint8_t n = 0; n < len; n++)
+        {
+            if(this->num_channels == MULTICHANNEL_16_CHANNELS)
+            {
+                SLICE_PAIR(low[n], high[n], slices);
+                this->encode_slices(slices, 8, data_out);
+                data_out = data_out + 32;
+                continue;
+            }
+
+            // 8 channels: two byte positions in each slices pair
+            SLICE_PAIR(low[n], (n + 1 < len) ? low[n + 1] : 0, slices);
+            for(uint8_t k = 0; k < 8; k++)
+            {
+                slices[k + 8] = slices[k] >> 8;
+                slices[k] = slices[k] & 0xFF;
+            }
+            if(n + 1 < len)
+            {
+                this->encode_slices(slices, 16, data_out);
+                data_out = data_out + 32;
+                n = n + 1;
+            }
+            else
+            {
+                this->encode_slices(slices, 8, data_out);
+                data_out = data_out + 16;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get the signal level of each channel (bit c for channel c) */
+uint16_t CDPMultiChannel::get_levels(void)
+{   return this->levels;   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Encode bit slices of all the channels into chip words, 4 chips
+  * of 16 channels or 8 chips of 8 channels for each 64 bits store.
+  * @param  slices Pointer to the slices (one data bit of every channel).
+  * @param  num_slices Number of slices (multiple of 4).
+  * @param  data_out Pointer to store the chip words (num_slices*2 words).
+  */
+void CDPMultiChannel::encode_slices(const uint16_t* slices,
+        const uint8_t num_slices, uint8_t* data_out)
+{
+    const uint16_t mask = (this->num_channels == MULTICHANNEL_8_CHANNELS) ?
+            0x00FF : 0xFFFF;
+    const uint8_t chip_bits = this->num_channels;
+    const uint8_t step = 32 / chip_bits;
+    uint16_t levels = this->levels;
+
+    for(uint8_t k = 0; k < num_slices; k = k + step)
+    {
+        uint64_t chips = 0;
+        for(uint8_t j = 0; j < step; j++)
+        {
+            levels = levels ^ slices[k + j];
+            chips = chips |
+                    ((uint64_t)(~levels & mask) << (2*j*chip_bits)) |
+                    ((uint64_t)levels << ((2*j + 1)*chip_bits));
+        }
+        store_le64(data_out, chips);
+        data_out = data_out + 8;
+    }
+    this->levels = levels;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    cdp_multichannel.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Bit-sliced Conditional DePhase (Differential Manchester) encoder of 8 or
+ * 16 independent channels for parallel output ports (GPIO/FPGA), where each
+ * output byte or word holds one chip of each channel.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_MULTICHANNEL_H_
+#define CDP_MULTICHANNEL_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Supported number of channels (one output byte or 16 bits word per chip)
+#define MULTICHANNEL_8_CHANNELS  8
+#define MULTICHANNEL_16_CHANNELS 16
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPMultiChannel
+{
+    public:
+
+        CDPMultiChannel();
+        ~CDPMultiChannel();
+
+        bool setup(const uint8_t num_channels);
+        void reset(void);
+
+        bool encode(const uint8_t* const* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len);
+
+        uint16_t get_levels(void);
+
+    private:
+
+        uint8_t num_channels;
+        uint16_t levels;
+
+        void encode_slices(const uint16_t* slices, const uint8_t num_slices,
+                uint8_t* data_out);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_MULTICHANNEL_H_ */
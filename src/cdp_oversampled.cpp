@@ -0,0 +1,262 @@
+/**
+ * @file    cdp_oversampled.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) decoder for oversampled
+ * line captures, with clock recovery through a digital PLL.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_oversampled.h"
+#include "cdp_bits.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Fixed point fractional bits used for time values (in samples)
+#define TIME_FRAC_BITS 16
+
+// PLL phase and frequency loop gains (as right shifts of the phase error)
+#define PLL_PHASE_GAIN_SHIFT 2
+#define PLL_FREQ_GAIN_SHIFT 5
+
+// Maximum deviation of the chip period from nominal (as right shift)
+#define PLL_MAX_DEVIATION_SHIFT 3
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPOversampled constructor */
+CDPOversampled::CDPOversampled()
+{
+    this->setup(1.0, NULL, 0, NULL, NULL);
+}
+
+/* CDPOversampled destructor */
+CDPOversampled::~CDPOversampled()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup the decoder and reset its state.
+  * @param  samples_per_chip Nominal number of samples for each chip
+  * (i.e. 4.0 to 16.0, can be fractional).
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at flush (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Setup result ok (true/false if samples per chip is invalid).
+  */
+bool CDPOversampled::setup(const float samples_per_chip, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    if(samples_per_chip < 1.0)
+        return false;
+
+    this->nominal_period = (int64_t)(samples_per_chip *
+            (1 << TIME_FRAC_BITS));
+    this->Decoder.setup(data_out, data_out_len, callback, callback_arg);
+    this->reset();
+
+    return true;
+}
+
+/**
+  * @brief  Reset decoder state to the start of a capture. First sample of
+  * the capture is expected to be the start of the first chip.
+  */
+void CDPOversampled::reset(void)
+{
+    this->Decoder.reset();
+    this->chip_period = this->nominal_period;
+    this->chip_start = 0;
+    this->num_samples = 0;
+    this->current_signal_level = 0;
+    this->error = false;
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Decode a piece of an oversampled capture. It can be called
+  * successive times with consecutive pieces of the capture.
+  * Samples are packed LSB-first (sample k is bit k%8 of byte k/8).
+  * Edges are located 64 samples at once, xoring each word with itself
+  * shifted one sample and walking the set bits with count-trailing-zeros,
+  * while idle periods without edges are skipped by 16 bytes blocks.
+  * @param  samples_in Pointer to packed samples.
+  * @param  samples_in_len Number of bytes of samples (8 samples per byte).
+  * @return Decode result ok (true/false on output overflow).
+  */
+bool CDPOversampled::decode(const uint8_t* samples_in,
+        const size_t samples_in_len)
+{
+    size_t i = 0;
+
+    if(this->error)
+        return false;
+    if(samples_in_len == 0)
+        return true;
+
+    // Get initial line level from the first sample of the capture
+    if(this->num_samples == 0)
+        this->current_signal_level = samples_in[0] & 0x01;
+
+    while(i < samples_in_len)
+    {
+        uint64_t word = 0;
+        uint64_t edges = 0;
+        uint8_t word_samples = 64;
+        size_t idle_len = 0;
+
+        // Skip idle line bytes
+        idle_len = idle_bytes_len(samples_in + i, samples_in_len - i,
+                this->current_signal_level);
+        this->num_samples = this->num_samples + (8 * idle_len);
+        i = i + idle_len;
+        if(i >= samples_in_len)
+            break;
+
+        // Get next samples word
+        if(i + 8 <= samples_in_len)
+        {
+            word = load_le64(samples_in + i);
+            i = i + 8;
+        }
+        else
+        {
+            word = samples_in[i];
+            word_samples = 8;
+            i = i + 1;
+        }
+
+        // Find edges: samples that differ from previous one
+        edges = word ^ ((word << 1) | this->current_signal_level);
+        if(word_samples < 64)
+            edges = edges & ((1ULL << word_samples) - 1);
+        while(edges != 0)
+        {
+            uint64_t edge_sample = this->num_samples + ctz64(edges);
+            if(this->process_edge((int64_t)(edge_sample << TIME_FRAC_BITS))
+                    == false)
+                return false;
+            this->current_signal_level = this->current_signal_level ^ 0x01;
+            edges = edges & (edges - 1);
+        }
+        this->num_samples = this->num_samples + word_samples;
+    }
+
+    // Output the chips already sampled by the end of this piece
+    return this->process_until((int64_t)(this->num_samples << TIME_FRAC_BITS));
+}
+
+/**
+  * @brief  Flush decoded bytes pending in the output array to the callback.
+  * @return Flush result ok (true/false if some output overflow happened).
+  */
+bool CDPOversampled::flush(void)
+{
+    return (this->Decoder.flush() && !(this->error));
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get number of decoded bytes currently stored in the output array */
+size_t CDPOversampled::get_decoded_len(void)
+{   return this->Decoder.get_decoded_len();   }
+
+/* Get current recovered samples per chip value */
+float CDPOversampled::get_samples_per_chip(void)
+{   return ((float)this->chip_period / (1 << TIME_FRAC_BITS));   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Output all chips with its middle point before given time (all
+  * of them have current signal level as no edge happened since the last
+  * one processed).
+  * @param  time Time (in fixed point samples) to output chips until.
+  * @return Result ok (true/false on output overflow).
+  */
+bool CDPOversampled::process_until(const int64_t time)
+{
+    while(this->chip_start + (this->chip_period / 2) < time)
+    {
+        if(this->Decoder.push_chip(this->current_signal_level) == false)
+        {
+            this->error = true;
+            return false;
+        }
+        this->chip_start = this->chip_start + this->chip_period;
+    }
+    return true;
+}
+
+/**
+  * @brief  Digital PLL edge processing. Chips before the edge are output
+  * and then the edge is compared with the expected chip boundary to
+  * correct chip phase (proportional term) and chip period (integral term).
+  * @param  edge_time Time (in fixed point samples) of the edge.
+  * @return Result ok (true/false on output overflow).
+  */
+bool CDPOversampled::process_edge(const int64_t edge_time)
+{
+    int64_t phase_error = 0;
+    int64_t max_deviation = this->nominal_period >> PLL_MAX_DEVIATION_SHIFT;
+
+    if(this->process_until(edge_time) == false)
+        return false;
+
+    // Edge should be at current chip start boundary
+    phase_error = edge_time - this->chip_start;
+    this->chip_start = this->chip_start +
+            (phase_error / (1 << PLL_PHASE_GAIN_SHIFT));
+    this->chip_period = this->chip_period +
+            (phase_error / (1 << PLL_FREQ_GAIN_SHIFT));
+
+    // Keep recovered period inside the allowed range
+    if(this->chip_period > this->nominal_period + max_deviation)
+        this->chip_period = this->nominal_period + max_deviation;
+    if(this->chip_period < this->nominal_period - max_deviation)
+        this->chip_period = this->nominal_period - max_deviation;
+
+    return true;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file    cdp_oversampled.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) decoder for oversampled
+ * line captures (i.e. logic analyzer samples taken at several times the
+ * chip rate), with clock recovery through a digital PLL.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_OVERSAMPLED_H_
+#define CDP_OVERSAMPLED_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp_stream.h"
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPOversampled
+{
+    public:
+
+        CDPOversampled();
+        ~CDPOversampled();
+
+        bool setup(const float samples_per_chip, uint8_t* data_out,
+                const size_t data_out_len, cdp_stream_cb callback,
+                void* callback_arg);
+        void reset(void);
+
+        bool decode(const uint8_t* samples_in, const size_t samples_in_len);
+        bool flush(void);
+
+        size_t get_decoded_len(void);
+        float get_samples_per_chip(void);
+
+    private:
+
+        CDPStreamDecoder Decoder;
+
+        int64_t nominal_period;
+        int64_t chip_period;
+        int64_t chip_start;
+        uint64_t num_samples;
+        uint8_t current_signal_level;
+        bool error;
+
+        bool process_edge(const int64_t edge_time);
+        bool process_until(const int64_t time);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_OVERSAMPLED_H_ */
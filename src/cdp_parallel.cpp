@@ -0,0 +1,417 @@
+/**
+ * @file    cdp_parallel.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Frame-level parallel decoder of IEEE 802.5 (Token Ring) captures.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_parallel.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Load 64 chips from any byte position of a packed chip stream,
+  * with zeros past its end.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_bytes Number of bytes of the chip stream.
+  * @param  byte_n Byte position to load from.
+  * @return Loaded chips.
+  */
+static inline uint64_t LOAD_CHIPS(const uint8_t* chips,
+        const uint64_t num_bytes, const uint64_t byte_n)
+{
+    if(byte_n + 8 <= num_bytes)
+        return load_le64(chips + byte_n);
+    if(byte_n >= num_bytes)
+        return 0;
+    return load_le64_len(chips + byte_n, (uint8_t)(num_bytes - byte_n));
+}
+
+/**
+  * @brief  Copy chips from any chip position of a packed chip stream to a
+  * byte aligned buffer, 64 chips at once.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips of the stream.
+  * @param  start_chip Position of the first chip to copy.
+  * @param  chips_out Pointer to output buffer.
+  * @param  chips_out_len Number of bytes to copy to the output buffer.
+  */
+static void EXTRACT_CHIPS(const uint8_t* chips, const uint64_t num_chips,
+        const uint64_t start_chip, uint8_t* chips_out,
+        const size_t chips_out_len)
+{
+    const uint64_t num_bytes = (num_chips + 7) / 8;
+    const uint8_t shift = start_chip % 8;
+    uint64_t byte_n = start_chip / 8;
+
+    for(size_t i = 0; i < chips_out_len; i += 8)
+    {
+        uint64_t word = LOAD_CHIPS(chips, num_bytes, byte_n);
+        if(shift > 0)
+        {
+            word = (word >> shift) | (LOAD_CHIPS(chips, num_bytes, byte_n + 8)
+                    << (64 - shift));
+        }
+        if(i + 8 <= chips_out_len)
+            store_le64(chips_out + i, word);
+        else
+            store_le64_len(chips_out + i, word, (uint8_t)(chips_out_len - i));
+        byte_n = byte_n + 8;
+    }
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPParallelDecoder constructor */
+CDPParallelDecoder::CDPParallelDecoder()
+{
+    this->num_threads = 0;
+    this->batch_n = 0;
+    this->num_busy = 0;
+    this->exit = false;
+    this->chips = NULL;
+    this->num_chips = 0;
+    this->data_out = NULL;
+    this->results = NULL;
+    for(uint8_t i = 0; i < PARALLEL_MAX_THREADS; i++)
+        this->ranges[i].range = 0;
+}
+
+/* CDPParallelDecoder destructor */
+CDPParallelDecoder::~CDPParallelDecoder()
+{
+    this->stop_threads();
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Setup the decoder threads pool.
+  * @param  num_threads Number of threads that decode frames (1 to
+  * PARALLEL_MAX_THREADS, including the thread that calls decode()).
+  * @return Setup result ok (true/false).
+  */
+bool CDPParallelDecoder::setup(const uint8_t num_threads)
+{
+    if((num_threads == 0) || (num_threads > PARALLEL_MAX_THREADS))
+        return false;
+
+    this->stop_threads();
+    this->num_threads = num_threads;
+    this->exit = false;
+    for(uint8_t i = 1; i < num_threads; i++)
+    {
+        this->threads[i] = std::thread(&CDPParallelDecoder::pool_thread, this,
+                i, this->batch_n);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Decode all the frames and tokens of a raw chips capture. Frames
+  * are found in batches, and each batch is split between the pool threads
+  * (idle threads steal half of the remaining frames of another thread).
+  * Each frame is decoded to its own place of the output data, so results
+  * are in capture order without further sorting.
+  * @param  chips Pointer to packed chips (LSB-first, as encode() output).
+  * @param  num_chips Number of chips of the capture.
+  * @param  data_out Pointer to output data array to store decoded frames.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  results Pointer to array to store the frames results.
+  * @param  results_len Number of elements of the results array.
+  * @return Number of frames decoded (it stops when the output data or the
+  * results array gets full).
+  */
+size_t CDPParallelDecoder::decode(const uint8_t* chips,
+        const uint64_t num_chips, uint8_t* data_out,
+        const size_t data_out_len, cdp_frame_result_t* results,
+        const size_t results_len)
+{
+    size_t num_results = 0;
+    size_t data_len = 0;
+    uint64_t start_chip = 0;
+    bool full = false;
+
+    if(this->num_threads == 0)
+        return 0;
+
+    this->chips = chips;
+    this->num_chips = num_chips;
+    this->data_out = data_out;
+    this->results = results;
+
+    while((full == false) && (num_results < results_len))
+    {
+        size_t batch_len = results_len - num_results;
+        if(batch_len > PARALLEL_BATCH_FRAMES)
+            batch_len = PARALLEL_BATCH_FRAMES;
+        batch_len = this->Scanner.find_frames(chips, num_chips, start_chip,
+                this->bounds, batch_len);
+        if(batch_len == 0)
+            break;
+        start_chip = this->bounds[batch_len - 1].end_chip;
+
+        // Place of each frame in the output data
+        for(size_t i = 0; i < batch_len; i++)
+        {
+            cdp_frame_result_t* result = &(results[num_results + i]);
+            uint64_t frame_chips = this->bounds[i].end_chip -
+                    this->bounds[i].start_chip;
+            size_t frame_len = frame_chips / 16;
+
+            if((frame_len > FRAME_TOKEN_LEN) &&
+               (this->bounds[i].end_chip + 16 <= num_chips))
+                frame_len = frame_len + 1;
+            if((frame_chips % 16 != 0) ||
+               (frame_len > PARALLEL_MAX_FRAME_LEN))
+                frame_len = 0;
+            if(data_len + frame_len > data_out_len)
+            {
+                batch_len = i;
+                full = true;
+                break;
+            }
+            result->bounds = this->bounds[i];
+            result->data = data_len;
+            result->data_len = frame_len;
+            result->result = FRAME_RESULT_LEN_ERROR;
+            memset(&(result->view), 0, sizeof(cdp_frame_view_t));
+            data_len = data_len + frame_len;
+        }
+
+        // Split the batch between the threads and run it
+        for(uint8_t i = 0; i < this->num_threads; i++)
+        {
+            uint64_t first = num_results + (batch_len * i) / this->num_threads;
+            uint64_t end = num_results +
+                    (batch_len * (i + 1)) / this->num_threads;
+            this->ranges[i].range.store((first << 32) | end);
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->num_busy = this->num_threads - 1;
+            this->batch_n = this->batch_n + 1;
+        }
+        this->start_cv.notify_all();
+        this->run_batch(0);
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->done_cv.wait(lock, [this]{ return this->num_busy == 0; });
+        }
+        num_results = num_results + batch_len;
+    }
+
+    return num_results;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Pool thread, that runs each batch until the pool is stopped.
+  * @param  thread_n Thread number.
+  * @param  batch_n Number of the last batch run before the thread start.
+  */
+void CDPParallelDecoder::pool_thread(const uint8_t thread_n,
+        uint64_t batch_n)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->start_cv.wait(lock, [this, batch_n]{
+                    return this->exit || (this->batch_n != batch_n); });
+            if(this->exit)
+                return;
+            batch_n = this->batch_n;
+        }
+        this->run_batch(thread_n);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->num_busy = this->num_busy - 1;
+            if(this->num_busy == 0)
+                this->done_cv.notify_one();
+        }
+    }
+}
+
+/**
+  * @brief  Stop and join the pool threads.
+  */
+void CDPParallelDecoder::stop_threads(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->exit = true;
+    }
+    this->start_cv.notify_all();
+    for(uint8_t i = 1; i < this->num_threads; i++)
+        this->threads[i].join();
+    this->num_threads = 0;
+}
+
+/**
+  * @brief  Decode frames of the thread range, and then frames stolen from
+  * the other threads, until there are no frames left.
+  * @param  thread_n Thread number.
+  */
+void CDPParallelDecoder::run_batch(const uint8_t thread_n)
+{
+    uint32_t frame_n = 0;
+
+    while(true)
+    {
+        if(this->take_frame(thread_n, &frame_n))
+            this->decode_frame(thread_n, &(this->results[frame_n]));
+        else if(this->steal_frames(thread_n) == false)
+            break;
+    }
+}
+
+/**
+  * @brief  Take the first frame of the thread range.
+  * @param  thread_n Thread number.
+  * @param  frame_n Pointer to store the frame index.
+  * @return Frame taken (true/false, false if the range is empty).
+  */
+bool CDPParallelDecoder::take_frame(const uint8_t thread_n,
+        uint32_t* frame_n)
+{
+    std::atomic<uint64_t>* range = &(this->ranges[thread_n].range);
+    uint64_t value = range->load();
+
+    while(true)
+    {
+        uint32_t first = (uint32_t)(value >> 32);
+        uint32_t end = (uint32_t)value;
+        if(first >= end)
+            return false;
+        if(range->compare_exchange_weak(value,
+                ((uint64_t)(first + 1) << 32) | end))
+        {
+            *frame_n = first;
+            return true;
+        }
+    }
+}
+
+/**
+  * @brief  Steal the last half of the frames range of another thread (the
+  * thread own range must be empty).
+  * @param  thread_n Thread number.
+  * @return Frames stolen (true/false, false if all ranges are empty).
+  */
+bool CDPParallelDecoder::steal_frames(const uint8_t thread_n)
+{
+    for(uint8_t i = 1; i < this->num_threads; i++)
+    {
+        uint8_t victim = (thread_n + i) % this->num_threads;
+        std::atomic<uint64_t>* range = &(this->ranges[victim].range);
+        uint64_t value = range->load();
+
+        while(true)
+        {
+            uint32_t first = (uint32_t)(value >> 32);
+            uint32_t end = (uint32_t)value;
+            uint32_t middle = end - ((end - first + 1) / 2);
+            if(first >= end)
+                break;
+            if(range->compare_exchange_weak(value,
+                    ((uint64_t)first << 32) | middle))
+            {
+                this->ranges[thread_n].range.store(
+                        ((uint64_t)middle << 32) | end);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+  * @brief  Decode a frame, check that there are no J/K symbols between its
+  * delimiters and check its frame check sequence.
+  * @param  thread_n Thread number (selects the thread work buffers).
+  * @param  result Pointer to frame result (with frame place already set).
+  */
+void CDPParallelDecoder::decode_frame(const uint8_t thread_n,
+        cdp_frame_result_t* result)
+{
+    uint8_t* chips = this->chips_buffers[thread_n];
+    uint8_t* jk = this->jk_buffers[thread_n];
+    uint8_t* data = this->data_out + result->data;
+    size_t frame_len = (size_t)((result->bounds.end_chip -
+            result->bounds.start_chip) / 16);
+    uint8_t level = result->bounds.level;
+
+    if(result->data_len == 0)
+        return;
+
+    EXTRACT_CHIPS(this->chips, this->num_chips, result->bounds.start_chip,
+            chips, result->data_len*2);
+    this->Cdp.decode_symbols(chips, result->data_len*2, data, jk,
+            result->data_len, &level);
+
+    if(idle_bytes_len(jk + 1, frame_len - 2, LOGIC_LEVEL_LOW) != frame_len - 2)
+    {
+        result->result = FRAME_RESULT_CODE_ERROR;
+        return;
+    }
+    if(frame_len == FRAME_TOKEN_LEN)
+    {
+        result->result = FRAME_RESULT_TOKEN;
+        return;
+    }
+    if(this->Frame.parse(this->data_out, result->data + 1, frame_len - 2,
+            &(result->view)) == false)
+        return;
+
+    result->view.ed_bits = data[frame_len - 1] &
+            (DELIMITER_ED_I_BIT | DELIMITER_ED_E_BIT);
+    if((result->data_len > frame_len) && (jk[frame_len] == 0x00))
+        result->view.fs = data[frame_len];
+    if(result->view.fcs_ok)
+        result->result = FRAME_RESULT_OK;
+    else
+        result->result = FRAME_RESULT_FCS_ERROR;
+}
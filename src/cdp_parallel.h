@@ -0,0 +1,153 @@
+/**
+ * @file    cdp_parallel.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Frame-level parallel decoder of IEEE 802.5 (Token Ring) captures. Frame
+ * boundaries are found with the delimiter scanner, and then whole frames
+ * are decoded, validated and FCS checked by a work-stealing threads pool,
+ * with results given in capture order.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_PARALLEL_H_
+#define CDP_PARALLEL_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "cdp.h"
+#include "cdp_delimiter.h"
+#include "cdp_frame.h"
+#include "cdp_queue.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Maximum number of threads (including the caller thread)
+#define PARALLEL_MAX_THREADS 16
+
+// Longest frame decoded (SD to FS, bytes)
+#define PARALLEL_MAX_FRAME_LEN 18000
+
+// Frames found and dispatched to the pool on each step
+#define PARALLEL_BATCH_FRAMES 1024
+
+// Frame decode results
+#define FRAME_RESULT_OK         0   // Valid frame
+#define FRAME_RESULT_TOKEN      1   // Valid token
+#define FRAME_RESULT_FCS_ERROR  2   // Frame check sequence mismatch
+#define FRAME_RESULT_CODE_ERROR 3   // J/K symbols between delimiters
+#define FRAME_RESULT_LEN_ERROR  4   // Not whole bytes, too short or too long
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Decoded frame */
+typedef struct
+{
+    cdp_frame_bounds_t bounds;  // Frame chips in the capture
+    size_t data;                // Offset of the decoded frame (SD to ED, and
+                                // FS if captured) in the output data
+    size_t data_len;            // Bytes of the decoded frame
+    cdp_frame_view_t view;      // Frame fields (offsets in the output data)
+    uint8_t result;             // FRAME_RESULT_* value
+} cdp_frame_result_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPParallelDecoder
+{
+    public:
+
+        CDPParallelDecoder();
+        ~CDPParallelDecoder();
+
+        bool setup(const uint8_t num_threads);
+        size_t decode(const uint8_t* chips, const uint64_t num_chips,
+                uint8_t* data_out, const size_t data_out_len,
+                cdp_frame_result_t* results, const size_t results_len);
+
+    private:
+
+        /* Frames range of a thread (first and end indexes packed in one
+           word, so owner and thieves take frames with a single CAS) */
+        struct alignas(QUEUE_CACHE_LINE_SIZE) frames_range_t
+        {
+            std::atomic<uint64_t> range;
+        };
+
+        CDP Cdp;
+        CDPFrame Frame;
+        CDPDelimiterScanner Scanner;
+        cdp_frame_bounds_t bounds[PARALLEL_BATCH_FRAMES];
+        uint8_t chips_buffers[PARALLEL_MAX_THREADS][PARALLEL_MAX_FRAME_LEN*2];
+        uint8_t jk_buffers[PARALLEL_MAX_THREADS][PARALLEL_MAX_FRAME_LEN];
+        frames_range_t ranges[PARALLEL_MAX_THREADS];
+        uint8_t num_threads;
+
+        // Pool threads state
+        std::thread threads[PARALLEL_MAX_THREADS];
+        std::mutex mutex;
+        std::condition_variable start_cv;
+        std::condition_variable done_cv;
+        uint64_t batch_n;
+        uint8_t num_busy;
+        bool exit;
+
+        // Current batch
+        const uint8_t* chips;
+        uint64_t num_chips;
+        uint8_t* data_out;
+        cdp_frame_result_t* results;
+
+        void pool_thread(const uint8_t thread_n, uint64_t batch_n);
+        void stop_threads(void);
+        void run_batch(const uint8_t thread_n);
+        bool take_frame(const uint8_t thread_n, uint32_t* frame_n);
+        bool steal_frames(const uint8_t thread_n);
+        void decode_frame(const uint8_t thread_n, cdp_frame_result_t* result);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_PARALLEL_H_ */
@@ -0,0 +1,123 @@
+/**
+ * @file    cdp_queue.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Lock-free single producer single consumer queue of fixed size, to pass
+ * items (i.e. pointers to chip buffers) between two threads.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_QUEUE_H_
+#define CDP_QUEUE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <atomic>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Bytes of a cache line (producer and consumer indexes are kept apart)
+#define QUEUE_CACHE_LINE_SIZE 64
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+template <typename T, size_t SIZE>
+class CDPQueue
+{
+    static_assert((SIZE & (SIZE - 1)) == 0, "Queue size must be power of 2");
+
+    public:
+
+        CDPQueue() : head(0), tail_cache(0), tail(0), head_cache(0)
+        {}
+
+        /**
+          * @brief  Add an item to the queue (producer thread only).
+          * @param  item Item to add.
+          * @return Push result ok (true/false, false if queue is full).
+          */
+        bool push(const T& item)
+        {
+            const size_t t = this->tail.load(std::memory_order_relaxed);
+            if(t - this->head_cache == SIZE)
+            {
+                this->head_cache = this->head.load(std::memory_order_acquire);
+                if(t - this->head_cache == SIZE)
+                    return false;
+            }
+            this->items[t & (SIZE - 1)] = item;
+            this->tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+          * @brief  Take the oldest item of the queue (consumer thread only).
+          * @param  item Pointer to store the item.
+          * @return Pop result ok (true/false, false if queue is empty).
+          */
+        bool pop(T* item)
+        {
+            const size_t h = this->head.load(std::memory_order_relaxed);
+            if(h == this->tail_cache)
+            {
+                this->tail_cache = this->tail.load(std::memory_order_acquire);
+                if(h == this->tail_cache)
+                    return false;
+            }
+            *item = this->items[h & (SIZE - 1)];
+            this->head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+    private:
+
+        // Consumer side
+        alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> head;
+        size_t tail_cache;
+
+        // Producer side
+        alignas(QUEUE_CACHE_LINE_SIZE) std::atomic<size_t> tail;
+        size_t head_cache;
+
+        alignas(QUEUE_CACHE_LINE_SIZE) T items[SIZE];
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_QUEUE_H_ */
@@ -0,0 +1,374 @@
+/**
+ * @file    cdp_ring.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Multithreaded IEEE 802.5 (Token Ring) network simulator.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_ring.h"
+#include "cdp_delimiter.h"
+
+#include <string.h>
+
+#include <chrono>
+#include <thread>
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Get a monotonic time value.
+  * @return Time in nanoseconds.
+  */
+static inline uint64_t NOW_NS(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+  * @brief  Get next value of a xorshift pseudo-random generator.
+  * @param  state Pointer to generator state (non-zero).
+  * @return Pseudo-random value.
+  */
+static inline uint32_t XORSHIFT32(uint32_t* state)
+{
+    uint32_t x = *state;
+    x = x ^ (x << 13);
+    x = x ^ (x >> 17);
+    x = x ^ (x << 5);
+    *state = x;
+    return x;
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPRing constructor */
+CDPRing::CDPRing()
+{
+    this->num_stations = 0;
+    this->num_threads = 0;
+    this->frames_per_station = 0;
+    this->payload_len = 0;
+    this->early_token_release = false;
+    this->frames_done = 0;
+    this->stop = false;
+}
+
+/* CDPRing destructor */
+CDPRing::~CDPRing()
+{}
+
+/*****************************************************************************/
+
+/* Simulation Methods */
+
+/**
+  * @brief  Setup the ring to simulate.
+  * @param  num_stations Number of stations of the ring (1 to
+  * RING_MAX_STATIONS).
+  * @param  num_threads Number of worker threads (1 to RING_MAX_THREADS, no
+  * more than stations). Station n runs on thread n % num_threads, so
+  * consecutive stations exchange buffers between different threads.
+  * @param  frames_per_station Number of frames each station sends (to
+  * random destination stations).
+  * @param  payload_len Number of payload bytes of each frame.
+  * @param  early_token_release Release the token just after sending a frame
+  * (instead of after stripping it), so several frames go around at once.
+  * @return Setup result ok (true/false).
+  */
+bool CDPRing::setup(const uint8_t num_stations, const uint8_t num_threads,
+        const uint32_t frames_per_station, const uint16_t payload_len,
+        const bool early_token_release)
+{
+    uint32_t random = 0x12345678;
+
+    if((num_stations == 0) || (num_stations > RING_MAX_STATIONS))
+        return false;
+    if((num_threads == 0) || (num_threads > RING_MAX_THREADS) ||
+       (num_threads > num_stations))
+        return false;
+    if(payload_len > RING_MAX_PAYLOAD_LEN)
+        return false;
+
+    this->num_stations = num_stations;
+    this->num_threads = num_threads;
+    this->frames_per_station = frames_per_station;
+    this->payload_len = payload_len;
+    this->early_token_release = early_token_release;
+    for(uint16_t i = 0; i < payload_len; i++)
+        this->payload[i] = (uint8_t)XORSHIFT32(&random);
+
+    return true;
+}
+
+/**
+  * @brief  Run the simulation until all the stations have sent their frames
+  * and got them back.
+  * @param  stats Pointer to store the simulation results.
+  * @return Simulation result ok (true/false).
+  */
+bool CDPRing::run(cdp_ring_stats_t* stats)
+{
+    std::thread threads[RING_MAX_THREADS];
+    cdp_ring_buffer_t* buffer = NULL;
+    uint8_t data[RING_TOKEN_LEN] = { DELIMITER_SD_DATA, 0x00,
+            DELIMITER_ED_DATA };
+    uint8_t jk[RING_TOKEN_LEN] = { DELIMITER_SD_JK, 0x00, DELIMITER_ED_JK };
+    uint64_t start = 0;
+
+    if(this->num_stations == 0)
+        return false;
+    memset(stats, 0, sizeof(cdp_ring_stats_t));
+
+    // Stations initial state
+    for(uint8_t i = 0; i < this->num_stations; i++)
+    {
+        cdp_ring_station_t* station = &(this->stations[i]);
+        while(station->queue.pop(&buffer));
+        station->token = NULL;
+        memset(station->address, 0, FRAME_ADDR_LEN);
+        station->address[0] = 0x40;
+        station->address[FRAME_ADDR_LEN - 1] = i;
+        station->level = INITIAL_SIGNAL_LEVEL;
+        station->frames_left = this->frames_per_station;
+        station->frame_sent = false;
+        station->random = 0x9E3779B9 ^ (i + 1);
+        station->frames = 0;
+        station->frames_copied = 0;
+        station->frames_errors = 0;
+        station->hops = 0;
+        station->chips = 0;
+        station->latency_sum = 0;
+        station->latency_max = 0;
+    }
+    this->frames_done = 0;
+    this->stop = (this->frames_per_station == 0);
+
+    // Token to the first station, and start the workers
+    this->token.level = INITIAL_SIGNAL_LEVEL;
+    this->token.len = RING_TOKEN_LEN*2;
+    this->Cdp.encode_symbols(data, jk, RING_TOKEN_LEN, this->token.chips,
+            this->token.len, &(this->token.level));
+    this->token.level = INITIAL_SIGNAL_LEVEL;
+    this->token.timestamp = NOW_NS();
+    this->stations[0].queue.push(&(this->token));
+    start = NOW_NS();
+    for(uint8_t i = 0; i < this->num_threads; i++)
+        threads[i] = std::thread(&CDPRing::worker, this, i);
+    for(uint8_t i = 0; i < this->num_threads; i++)
+        threads[i].join();
+    stats->seconds = (NOW_NS() - start) / 1e9;
+
+    // Results
+    for(uint8_t i = 0; i < this->num_stations; i++)
+    {
+        cdp_ring_station_t* station = &(this->stations[i]);
+        stats->frames += station->frames;
+        stats->frames_copied += station->frames_copied;
+        stats->frames_errors += station->frames_errors;
+        stats->hops += station->hops;
+        stats->chips += station->chips;
+        stats->hop_latency_avg_us += station->latency_sum / 1e3;
+        if(station->latency_max / 1e3 > stats->hop_latency_max_us)
+            stats->hop_latency_max_us = station->latency_max / 1e3;
+    }
+    if(stats->hops > 0)
+        stats->hop_latency_avg_us = stats->hop_latency_avg_us / stats->hops;
+    if(stats->seconds > 0)
+    {
+        stats->frames_per_second = stats->frames / stats->seconds;
+        stats->chips_per_second = stats->chips / stats->seconds;
+    }
+
+    return (stats->frames ==
+            (uint64_t)this->num_stations * this->frames_per_station);
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Worker thread, that runs its stations until the simulation ends.
+  * @param  thread_n Worker thread number.
+  */
+void CDPRing::worker(const uint8_t thread_n)
+{
+    cdp_ring_buffer_t* buffer = NULL;
+
+    while(this->stop.load(std::memory_order_acquire) == false)
+    {
+        bool busy = false;
+        for(uint8_t i = thread_n; i < this->num_stations;
+                i += this->num_threads)
+        {
+            if(this->stations[i].queue.pop(&buffer) == false)
+                continue;
+            this->station_receive(i, buffer);
+            busy = true;
+        }
+        if(busy == false)
+            std::this_thread::yield();
+    }
+}
+
+/**
+  * @brief  Handle a token or frame received by a station: the token is
+  * captured to send a frame (if any pending), own frames are stripped and
+  * frames to the station are copied (setting frame status bits). All the
+  * rest is decoded and encoded again to the next station.
+  * @param  station_n Station number.
+  * @param  buffer Pointer to received buffer.
+  */
+void CDPRing::station_receive(const uint8_t station_n,
+        cdp_ring_buffer_t* buffer)
+{
+    cdp_ring_station_t* station = &(this->stations[station_n]);
+    const size_t data_len = buffer->len / 2;
+    uint64_t latency = NOW_NS() - buffer->timestamp;
+    uint8_t level = buffer->level;
+
+    station->hops = station->hops + 1;
+    station->latency_sum = station->latency_sum + latency;
+    if(latency > station->latency_max)
+        station->latency_max = latency;
+
+    this->Cdp.decode_symbols(buffer->chips, buffer->len, station->data,
+            station->jk, data_len, &level);
+    station->chips = station->chips + buffer->len*8;
+
+    // Token
+    if((station->data[1] & RING_AC_TOKEN_BIT) == 0)
+    {
+        if((station->frames_left == 0) || station->frame_sent)
+        {
+            this->station_repeat(station_n, buffer, data_len);
+            return;
+        }
+        uint8_t da[FRAME_ADDR_LEN];
+        uint8_t dest = station_n;
+        if(this->num_stations > 1)
+            dest = (station_n + 1 + (XORSHIFT32(&(station->random)) %
+                    (this->num_stations - 1))) % this->num_stations;
+        memcpy(da, station->address, FRAME_ADDR_LEN);
+        da[FRAME_ADDR_LEN - 1] = dest;
+        station->frame.level = station->level;
+        station->frame.len = CDPFrame::get_encoded_len(this->payload_len);
+        this->Frame.build(RING_AC_TOKEN_BIT, 0x40, da, station->address,
+                this->payload, this->payload_len, station->frame.chips,
+                sizeof(station->frame.chips), &(station->level));
+        station->frames_left = station->frames_left - 1;
+        station->frame_sent = true;
+        this->station_send(station_n, &(station->frame));
+        if(this->early_token_release)
+            this->station_repeat(station_n, buffer, data_len);
+        else
+            station->token = buffer;
+        return;
+    }
+
+    // Own frame back (strip it and release the token, if held)
+    if(memcmp(station->data + 3 + FRAME_ADDR_LEN, station->address,
+            FRAME_ADDR_LEN) == 0)
+    {
+        uint8_t fs = station->data[data_len - 1];
+        station->frames = station->frames + 1;
+        if((fs & RING_FS_C_BITS) == RING_FS_C_BITS)
+            station->frames_copied = station->frames_copied + 1;
+        station->frame_sent = false;
+        if(station->token != NULL)
+        {
+            buffer = station->token;
+            station->token = NULL;
+            level = buffer->level;
+            this->Cdp.decode_symbols(buffer->chips, buffer->len,
+                    station->data, station->jk, RING_TOKEN_LEN, &level);
+            this->station_repeat(station_n, buffer, RING_TOKEN_LEN);
+        }
+        if(this->frames_done.fetch_add(1) + 1 ==
+                (uint64_t)this->num_stations * this->frames_per_station)
+            this->stop.store(true, std::memory_order_release);
+        return;
+    }
+
+    // Frame to this station (copy it)
+    if(memcmp(station->data + 3, station->address, FRAME_ADDR_LEN) == 0)
+    {
+        cdp_frame_view_t view;
+        uint8_t* fs = &(station->data[data_len - 1]);
+        if(this->Frame.parse(station->data + 1, data_len - 3, &view) &&
+                view.fcs_ok)
+            *fs = *fs | RING_FS_A_BITS | RING_FS_C_BITS;
+        else
+        {
+            *fs = *fs | RING_FS_A_BITS;
+            station->data[data_len - 2] |= DELIMITER_ED_E_BIT;
+            station->frames_errors = station->frames_errors + 1;
+        }
+    }
+    this->station_repeat(station_n, buffer, data_len);
+}
+
+/**
+  * @brief  Encode again the station decoded data into a buffer and send it
+  * to the next station.
+  * @param  station_n Station number.
+  * @param  buffer Pointer to buffer to send.
+  * @param  data_len Number of decoded bytes.
+  */
+void CDPRing::station_repeat(const uint8_t station_n,
+        cdp_ring_buffer_t* buffer, const size_t data_len)
+{
+    cdp_ring_station_t* station = &(this->stations[station_n]);
+
+    buffer->level = station->level;
+    this->Cdp.encode_symbols(station->data, station->jk, data_len,
+            buffer->chips, buffer->len, &(station->level));
+    this->station_send(station_n, buffer);
+}
+
+/**
+  * @brief  Send a buffer to the next station of the ring.
+  * @param  station_n Station number.
+  * @param  buffer Pointer to buffer to send.
+  */
+void CDPRing::station_send(const uint8_t station_n,
+        cdp_ring_buffer_t* buffer)
+{
+    uint8_t next = (station_n + 1) % this->num_stations;
+
+    buffer->timestamp = NOW_NS();
+    while(this->stations[next].queue.push(buffer) == false)
+        std::this_thread::yield();
+}
@@ -0,0 +1,169 @@
+/**
+ * @file    cdp_ring.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Multithreaded IEEE 802.5 (Token Ring) network simulator for codec load
+ * tests. Stations are spread across worker threads and pass encoded chip
+ * buffers (token and frames) to the next station through lock-free
+ * queues; each station decodes and encodes again everything it repeats.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_RING_H_
+#define CDP_RING_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <atomic>
+
+#include "cdp.h"
+#include "cdp_frame.h"
+#include "cdp_queue.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Simulation limits
+#define RING_MAX_STATIONS    64
+#define RING_MAX_THREADS     16
+#define RING_MAX_PAYLOAD_LEN 4096
+
+// Station queues size (enough for all the buffers of the ring)
+#define RING_QUEUE_SIZE 128
+
+// Access control token bit (set on frames) and frame status address
+// recognized (A) and frame copied (C) bits (both sent twice)
+#define RING_AC_TOKEN_BIT 0x10
+#define RING_FS_A_BITS    0x88
+#define RING_FS_C_BITS    0x44
+
+// Bytes of a token (SD, AC and ED) and of the largest frame
+#define RING_TOKEN_LEN FRAME_TOKEN_LEN
+#define RING_MAX_FRAME_LEN (FRAME_OVERHEAD_LEN + RING_MAX_PAYLOAD_LEN)
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Simulation results */
+typedef struct
+{
+    uint64_t frames;            // Frames sent (and stripped by their source)
+    uint64_t frames_copied;     // Frames copied by their destination
+    uint64_t frames_errors;     // Frames with FCS error at destination
+    uint64_t hops;              // Token and frames repeats between stations
+    uint64_t chips;             // Chips decoded by all the stations
+    double seconds;             // Simulation time
+    double frames_per_second;
+    double chips_per_second;
+    double hop_latency_avg_us;  // Time from send to receive on each hop
+    double hop_latency_max_us;
+} cdp_ring_stats_t;
+
+/* Chip buffer that goes around the ring (token or frame) */
+typedef struct
+{
+    uint8_t chips[RING_MAX_FRAME_LEN*2];
+    size_t len;                 // Bytes of encoded chips
+    uint8_t level;              // Signal level before the chips
+    uint64_t timestamp;         // Send time (ns)
+} cdp_ring_buffer_t;
+
+/* Station state (only used by the thread that runs the station) */
+typedef struct
+{
+    CDPQueue<cdp_ring_buffer_t*, RING_QUEUE_SIZE> queue;
+    cdp_ring_buffer_t frame;    // Own frame buffer
+    cdp_ring_buffer_t* token;   // Token held while own frame goes around
+    uint8_t data[RING_MAX_FRAME_LEN];
+    uint8_t jk[RING_MAX_FRAME_LEN];
+    uint8_t address[FRAME_ADDR_LEN];
+    uint8_t level;
+    uint32_t frames_left;
+    bool frame_sent;
+    uint32_t random;
+    uint64_t frames;
+    uint64_t frames_copied;
+    uint64_t frames_errors;
+    uint64_t hops;
+    uint64_t chips;
+    uint64_t latency_sum;
+    uint64_t latency_max;
+} cdp_ring_station_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPRing
+{
+    public:
+
+        CDPRing();
+        ~CDPRing();
+
+        bool setup(const uint8_t num_stations, const uint8_t num_threads,
+                const uint32_t frames_per_station, const uint16_t payload_len,
+                const bool early_token_release);
+        bool run(cdp_ring_stats_t* stats);
+
+    private:
+
+        CDP Cdp;
+        CDPFrame Frame;
+        cdp_ring_station_t stations[RING_MAX_STATIONS];
+        cdp_ring_buffer_t token;
+        uint8_t payload[RING_MAX_PAYLOAD_LEN];
+        uint8_t num_stations;
+        uint8_t num_threads;
+        uint32_t frames_per_station;
+        uint16_t payload_len;
+        bool early_token_release;
+        std::atomic<uint64_t> frames_done;
+        std::atomic<bool> stop;
+
+        void worker(const uint8_t thread_n);
+        void station_receive(const uint8_t station_n,
+                cdp_ring_buffer_t* buffer);
+        void station_send(const uint8_t station_n,
+                cdp_ring_buffer_t* buffer);
+        void station_repeat(const uint8_t station_n,
+                cdp_ring_buffer_t* buffer, const size_t data_len);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_RING_H_ */
@@ -0,0 +1,591 @@
+/**
+ * @file    cdp_rope.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Editable encoded buffer for large data.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_rope.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Get data bytes of a subtree.
+  * @param  node Pointer to subtree root node (can be NULL).
+  * @return Number of data bytes.
+  */
+static inline uint64_t TREE_LEN(const cdp_rope_node_t* node)
+{   return (node == NULL) ? 0 : node->tree_len;   }
+
+/**
+  * @brief  Get the level change of a subtree.
+  * @param  node Pointer to subtree root node (can be NULL).
+  * @return Level change (0 or 1).
+  */
+static inline uint8_t TREE_PARITY(const cdp_rope_node_t* node)
+{   return (node == NULL) ? 0 : node->tree_parity;   }
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPRope constructor */
+CDPRope::CDPRope()
+{
+    this->root = NULL;
+    this->num_chunks = 0;
+    this->start_signal_level = INITIAL_SIGNAL_LEVEL;
+    this->random = 0x2545F491;
+}
+
+/* CDPRope destructor */
+CDPRope::~CDPRope()
+{
+    this->clear();
+}
+
+/*****************************************************************************/
+
+/* Edit Methods */
+
+/**
+  * @brief  Load data to the buffer (replacing its content).
+  * @param  data_in Pointer to data.
+  * @param  data_in_len Number of bytes of data.
+  * @param  start_signal_level Signal level before the data (LOW or HIGH).
+  * @return Load result ok (true/false).
+  */
+bool CDPRope::load(const uint8_t* data_in, const size_t data_in_len,
+        const uint8_t start_signal_level)
+{
+    this->clear();
+    this->start_signal_level = start_signal_level;
+    this->root = this->new_tree(data_in, data_in_len);
+
+    return true;
+}
+
+/**
+  * @brief  Insert data at a position. Data that fits in the chunk of that
+  * position is inserted in it, otherwise the tree is split at the position
+  * and new chunks are joined in (coalescing small chunks at the joins).
+  * @param  position Data byte position to insert at (up to get_len()).
+  * @param  data_in Pointer to data to insert.
+  * @param  data_in_len Number of bytes to insert.
+  * @return Insert result ok (true/false).
+  */
+bool CDPRope::insert(const uint64_t position, const uint8_t* data_in,
+        const size_t data_in_len)
+{
+    cdp_rope_node_t* left = NULL;
+    cdp_rope_node_t* right = NULL;
+
+    if(position > this->get_len())
+        return false;
+    if(data_in_len == 0)
+        return true;
+    if(this->insert_in_chunk(this->root, position, data_in, data_in_len))
+        return true;
+
+    this->split(this->root, position, &left, &right);
+    left = this->join(left, this->new_tree(data_in, data_in_len));
+    this->root = this->join(left, right);
+
+    return true;
+}
+
+/**
+  * @brief  Remove data from a position (the chunks remaining at both sides
+  * are coalesced if they fit in one chunk).
+  * @param  position Data byte position of the first byte to remove.
+  * @param  len Number of bytes to remove.
+  * @return Erase result ok (true/false).
+  */
+bool CDPRope::erase(const uint64_t position, const uint64_t len)
+{
+    cdp_rope_node_t* left = NULL;
+    cdp_rope_node_t* middle = NULL;
+    cdp_rope_node_t* right = NULL;
+
+    if((position > this->get_len()) || (len > this->get_len() - position))
+        return false;
+    if(len == 0)
+        return true;
+
+    this->split(this->root, position, &left, &right);
+    this->split(right, len, &middle, &right);
+    this->delete_tree(middle);
+    this->root = this->join(left, right);
+
+    return true;
+}
+
+/**
+  * @brief  Overwrite data from a position (only the chunks of that data are
+  * encoded again).
+  * @param  position Data byte position of the first byte to overwrite.
+  * @param  data_in Pointer to new data.
+  * @param  data_in_len Number of bytes to overwrite.
+  * @return Write result ok (true/false).
+  */
+bool CDPRope::write(const uint64_t position, const uint8_t* data_in,
+        const size_t data_in_len)
+{
+    if((position > this->get_len()) ||
+       (data_in_len > this->get_len() - position))
+        return false;
+    if(data_in_len == 0)
+        return true;
+
+    this->write_node(this->root, position, data_in, data_in_len);
+
+    return true;
+}
+
+/**
+  * @brief  Read encoded data (the encode of a range of the data, with the
+  * levels that the data before it gives).
+  * @param  position Data byte position of the first byte to read.
+  * @param  len Number of data bytes to read.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (len*2 needed).
+  * @return Read result ok (true/false).
+  */
+bool CDPRope::read(const uint64_t position, const uint64_t len,
+        uint8_t* data_out, const size_t data_out_len)
+{
+    if((position > this->get_len()) || (len > this->get_len() - position) ||
+       (len*2 > data_out_len))
+        return false;
+    if(len == 0)
+        return true;
+
+    this->read_node(this->root, position, len, this->start_signal_level,
+            data_out);
+
+    return true;
+}
+
+/**
+  * @brief  Remove all the data of the buffer.
+  */
+void CDPRope::clear(void)
+{
+    this->delete_tree(this->root);
+    this->root = NULL;
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/**
+  * @brief  Get the number of data bytes of the buffer.
+  * @return Number of data bytes.
+  */
+uint64_t CDPRope::get_len(void)
+{
+    return TREE_LEN(this->root);
+}
+
+/**
+  * @brief  Get the signal level at the end of the encoded data.
+  * @return Signal level (LOW or HIGH).
+  */
+uint8_t CDPRope::get_end_level(void)
+{
+    return this->start_signal_level ^ TREE_PARITY(this->root);
+}
+
+/**
+  * @brief  Get the number of chunks of the buffer.
+  * @return Number of chunks.
+  */
+uint64_t CDPRope::get_num_chunks(void)
+{
+    return this->num_chunks;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Create a tree node for a chunk of data.
+  * @param  data_in Pointer to chunk data.
+  * @param  data_in_len Number of bytes of chunk data (up to
+  * ROPE_CHUNK_SIZE).
+  * @return Pointer to the new node.
+  */
+cdp_rope_node_t* CDPRope::new_node(const uint8_t* data_in,
+        const size_t data_in_len)
+{
+    cdp_rope_node_t* node = new cdp_rope_node_t;
+
+    // Random priority (xorshift) keeps the tree balanced
+    this->random = this->random ^ (this->random << 13);
+    this->random = this->random ^ (this->random >> 17);
+    this->random = this->random ^ (this->random << 5);
+    node->priority = this->random;
+    node->left = NULL;
+    node->right = NULL;
+    this->encode_node(node, data_in, data_in_len);
+    this->num_chunks = this->num_chunks + 1;
+
+    return node;
+}
+
+/**
+  * @brief  Create a tree of full chunks for a block of data.
+  * @param  data_in Pointer to data.
+  * @param  data_in_len Number of bytes of data.
+  * @return Pointer to the tree root node (NULL if no data).
+  */
+cdp_rope_node_t* CDPRope::new_tree(const uint8_t* data_in,
+        const size_t data_in_len)
+{
+    cdp_rope_node_t* tree = NULL;
+
+    for(size_t i = 0; i < data_in_len; i += ROPE_CHUNK_SIZE)
+    {
+        size_t chunk_len = data_in_len - i;
+        if(chunk_len > ROPE_CHUNK_SIZE)
+            chunk_len = ROPE_CHUNK_SIZE;
+        tree = this->merge(tree, this->new_node(data_in + i, chunk_len));
+    }
+
+    return tree;
+}
+
+/**
+  * @brief  Free all the nodes of a tree.
+  * @param  node Pointer to the tree root node (can be NULL).
+  */
+void CDPRope::delete_tree(cdp_rope_node_t* node)
+{
+    if(node == NULL)
+        return;
+    this->delete_tree(node->left);
+    this->delete_tree(node->right);
+    delete node;
+    this->num_chunks = this->num_chunks - 1;
+}
+
+/**
+  * @brief  Encode the data of a node chunk (for HIGH starting level).
+  * @param  node Pointer to the node.
+  * @param  data_in Pointer to chunk data.
+  * @param  data_in_len Number of bytes of chunk data.
+  */
+void CDPRope::encode_node(cdp_rope_node_t* node, const uint8_t* data_in,
+        const size_t data_in_len)
+{
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    this->Cdp.encode(data_in, data_in_len, node->chips, data_in_len*2, &level);
+    node->len = (uint16_t)data_in_len;
+    node->parity = level ^ LOGIC_LEVEL_HIGH;
+    this->update(node);
+}
+
+/**
+  * @brief  Update the subtree length and level change of a node.
+  * @param  node Pointer to the node.
+  */
+void CDPRope::update(cdp_rope_node_t* node)
+{
+    node->tree_len = TREE_LEN(node->left) + node->len +
+            TREE_LEN(node->right);
+    node->tree_parity = TREE_PARITY(node->left) ^ node->parity ^
+            TREE_PARITY(node->right);
+}
+
+/**
+  * @brief  Join two trees (all the data of the left one goes first).
+  * @param  left Pointer to left tree root node (can be NULL).
+  * @param  right Pointer to right tree root node (can be NULL).
+  * @return Pointer to the joined tree root node.
+  */
+cdp_rope_node_t* CDPRope::merge(cdp_rope_node_t* left,
+        cdp_rope_node_t* right)
+{
+    if(left == NULL)
+        return right;
+    if(right == NULL)
+        return left;
+
+    if(left->priority > right->priority)
+    {
+        left->right = this->merge(left->right, right);
+        this->update(left);
+        return left;
+    }
+    right->left = this->merge(left, right->left);
+    this->update(right);
+    return right;
+}
+
+/**
+  * @brief  Join two trees (all the data of the left one goes first), and
+  * coalesce the last chunk of the left tree with the first chunk of the
+  * right tree if both fit in one chunk (so split and erase remainders don't
+  * pile up as small chunks).
+  * @param  left Pointer to left tree root node (can be NULL).
+  * @param  right Pointer to right tree root node (can be NULL).
+  * @return Pointer to the joined tree root node.
+  */
+cdp_rope_node_t* CDPRope::join(cdp_rope_node_t* left,
+        cdp_rope_node_t* right)
+{
+    uint8_t data[ROPE_CHUNK_SIZE];
+    cdp_rope_node_t* last = left;
+    cdp_rope_node_t* first = right;
+    cdp_rope_node_t* node = NULL;
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    if((left == NULL) || (right == NULL))
+        return this->merge(left, right);
+
+    while(last->right != NULL)
+        last = last->right;
+    while(first->left != NULL)
+        first = first->left;
+    if(last->len + first->len > ROPE_CHUNK_SIZE)
+        return this->merge(left, right);
+
+    // Detach both chunks (splits at chunk bounds don't split chunks)
+    this->split(left, TREE_LEN(left) - last->len, &left, &node);
+    this->split(right, first->len, &node, &right);
+
+    // Append the first chunk data of the right tree to the last chunk
+    this->Cdp.decode(last->chips, last->len*2, data, last->len, &level);
+    level = LOGIC_LEVEL_HIGH;
+    this->Cdp.decode(first->chips, first->len*2, data + last->len,
+            first->len, &level);
+    this->encode_node(last, data, last->len + first->len);
+    this->delete_tree(first);
+
+    return this->merge(this->merge(left, last), right);
+}
+
+/**
+  * @brief  Split a tree at a data position (the chunk of the position is
+  * split in two if the position is inside it).
+  * @param  node Pointer to the tree root node (can be NULL).
+  * @param  position Data byte position (first byte of the right tree).
+  * @param  left Pointer to store the left tree root node.
+  * @param  right Pointer to store the right tree root node.
+  */
+void CDPRope::split(cdp_rope_node_t* node, const uint64_t position,
+        cdp_rope_node_t** left, cdp_rope_node_t** right)
+{
+    uint8_t data[ROPE_CHUNK_SIZE];
+    uint64_t left_len = 0;
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    if(node == NULL)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    left_len = TREE_LEN(node->left);
+    if(position <= left_len)
+    {
+        this->split(node->left, position, left, &(node->left));
+        this->update(node);
+        *right = node;
+    }
+    else if(position >= left_len + node->len)
+    {
+        this->split(node->right, position - left_len - node->len,
+                &(node->right), right);
+        this->update(node);
+        *left = node;
+    }
+    else
+    {
+        // Split the chunk (the node keeps the first part)
+        size_t chunk_position = (size_t)(position - left_len);
+        this->Cdp.decode(node->chips, node->len*2, data, node->len, &level);
+        *right = this->merge(this->new_node(data + chunk_position,
+                node->len - chunk_position), node->right);
+        node->right = NULL;
+        this->encode_node(node, data, chunk_position);
+        *left = node;
+    }
+}
+
+/**
+  * @brief  Insert data in the chunk of a position, if it fits in it.
+  * @param  node Pointer to the tree root node (can be NULL).
+  * @param  position Data byte position to insert at.
+  * @param  data_in Pointer to data to insert.
+  * @param  data_in_len Number of bytes to insert.
+  * @return Data inserted (true/false).
+  */
+bool CDPRope::insert_in_chunk(cdp_rope_node_t* node, const uint64_t position,
+        const uint8_t* data_in, const size_t data_in_len)
+{
+    uint8_t data[ROPE_CHUNK_SIZE];
+    uint64_t left_len = 0;
+    uint8_t level = LOGIC_LEVEL_HIGH;
+    bool inserted = false;
+
+    if(node == NULL)
+        return false;
+
+    left_len = TREE_LEN(node->left);
+    if(position < left_len)
+    {
+        inserted = this->insert_in_chunk(node->left, position, data_in,
+                data_in_len);
+    }
+    else if(position > left_len + node->len)
+    {
+        inserted = this->insert_in_chunk(node->right,
+                position - left_len - node->len, data_in, data_in_len);
+    }
+    else if(node->len + data_in_len <= ROPE_CHUNK_SIZE)
+    {
+        size_t chunk_position = (size_t)(position - left_len);
+        this->Cdp.decode(node->chips, node->len*2, data, node->len, &level);
+        memmove(data + chunk_position + data_in_len, data + chunk_position,
+                node->len - chunk_position);
+        memcpy(data + chunk_position, data_in, data_in_len);
+        this->encode_node(node, data, node->len + data_in_len);
+        return true;
+    }
+
+    if(inserted)
+        this->update(node);
+    return inserted;
+}
+
+/**
+  * @brief  Overwrite data of the chunks of a tree.
+  * @param  node Pointer to the tree root node.
+  * @param  position Data byte position of the first byte to overwrite.
+  * @param  data_in Pointer to new data.
+  * @param  data_in_len Number of bytes to overwrite.
+  */
+void CDPRope::write_node(cdp_rope_node_t* node, const uint64_t position,
+        const uint8_t* data_in, const size_t data_in_len)
+{
+    uint8_t data[ROPE_CHUNK_SIZE];
+    const uint64_t left_len = TREE_LEN(node->left);
+    const uint64_t right_position = left_len + node->len;
+    const uint64_t end = position + data_in_len;
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    // Left subtree part
+    if(position < left_len)
+    {
+        uint64_t left_end = (end < left_len) ? end : left_len;
+        this->write_node(node->left, position, data_in,
+                (size_t)(left_end - position));
+    }
+
+    // Node chunk part
+    uint64_t first = (position > left_len) ? position : left_len;
+    uint64_t last = (end < right_position) ? end : right_position;
+    if(first < last)
+    {
+        this->Cdp.decode(node->chips, node->len*2, data, node->len, &level);
+        memcpy(data + (first - left_len), data_in + (first - position),
+                (size_t)(last - first));
+        this->encode_node(node, data, node->len);
+    }
+
+    // Right subtree part
+    if(end > right_position)
+    {
+        first = (position > right_position) ? position : right_position;
+        this->write_node(node->right, first - right_position,
+                data_in + (first - position), (size_t)(end - first));
+    }
+
+    this->update(node);
+}
+
+/**
+  * @brief  Read encoded data of the chunks of a tree, inverting the chunks
+  * with LOW level before them.
+  * @param  node Pointer to the tree root node.
+  * @param  position Data byte position of the first byte to read.
+  * @param  len Number of data bytes to read.
+  * @param  level Signal level before the tree data.
+  * @param  data_out Pointer to output encoded data.
+  */
+void CDPRope::read_node(cdp_rope_node_t* node, const uint64_t position,
+        const uint64_t len, uint8_t level, uint8_t* data_out)
+{
+    const uint64_t left_len = TREE_LEN(node->left);
+    const uint64_t right_position = left_len + node->len;
+    const uint64_t end = position + len;
+
+    // Left subtree part
+    if(position < left_len)
+    {
+        uint64_t left_end = (end < left_len) ? end : left_len;
+        this->read_node(node->left, position, left_end - position, level,
+                data_out);
+    }
+
+    // Node chunk part
+    level = level ^ TREE_PARITY(node->left);
+    uint64_t first = (position > left_len) ? position : left_len;
+    uint64_t last = (end < right_position) ? end : right_position;
+    if(first < last)
+    {
+        uint8_t* chips_out = data_out + (first - position)*2;
+        const uint8_t* chips = node->chips + (first - left_len)*2;
+        if(level == LOGIC_LEVEL_HIGH)
+            memcpy(chips_out, chips, (size_t)(last - first)*2);
+        else
+            copy_not(chips_out, chips, (size_t)(last - first)*2);
+    }
+
+    // Right subtree part
+    level = level ^ node->parity;
+    if(end > right_position)
+    {
+        first = (position > right_position) ? position : right_position;
+        this->read_node(node->right, first - right_position, end - first,
+                level, data_out + (first - position)*2);
+    }
+}
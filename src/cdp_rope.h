@@ -0,0 +1,135 @@
+/**
+ * @file    cdp_rope.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Editable encoded buffer for large data (i.e. test patterns). Data is kept
+ * as encoded chunks in a balanced tree (treap), each chunk encoded for a
+ * HIGH starting level. The actual polarity of a chunk is the parity of the
+ * data before it, that the tree keeps for each subtree, so an edit only
+ * encodes the edited chunks, and chunks inversion is only done when the
+ * buffer is read.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_ROPE_H_
+#define CDP_ROPE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Maximum data bytes of each chunk
+#define ROPE_CHUNK_SIZE 1024
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Tree node (chunk of data encoded for a HIGH starting level) */
+typedef struct cdp_rope_node
+{
+    struct cdp_rope_node* left;
+    struct cdp_rope_node* right;
+    uint32_t priority;
+    uint16_t len;               // Data bytes of the chunk
+    uint8_t parity;             // Chunk level change (xor of its data bits)
+    uint8_t tree_parity;        // Level change of the whole subtree
+    uint64_t tree_len;          // Data bytes of the whole subtree
+    uint8_t chips[ROPE_CHUNK_SIZE*2];
+} cdp_rope_node_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPRope
+{
+    public:
+
+        CDPRope();
+        ~CDPRope();
+
+        bool load(const uint8_t* data_in, const size_t data_in_len,
+                const uint8_t start_signal_level);
+        bool insert(const uint64_t position, const uint8_t* data_in,
+                const size_t data_in_len);
+        bool erase(const uint64_t position, const uint64_t len);
+        bool write(const uint64_t position, const uint8_t* data_in,
+                const size_t data_in_len);
+        bool read(const uint64_t position, const uint64_t len,
+                uint8_t* data_out, const size_t data_out_len);
+        void clear(void);
+
+        uint64_t get_len(void);
+        uint8_t get_end_level(void);
+        uint64_t get_num_chunks(void);
+
+    private:
+
+        CDP Cdp;
+        cdp_rope_node_t* root;
+        uint64_t num_chunks;
+        uint8_t start_signal_level;
+        uint32_t random;
+
+        cdp_rope_node_t* new_node(const uint8_t* data_in,
+                const size_t data_in_len);
+        cdp_rope_node_t* new_tree(const uint8_t* data_in,
+                const size_t data_in_len);
+        void delete_tree(cdp_rope_node_t* node);
+        void encode_node(cdp_rope_node_t* node, const uint8_t* data_in,
+                const size_t data_in_len);
+        void update(cdp_rope_node_t* node);
+        cdp_rope_node_t* merge(cdp_rope_node_t* left,
+                cdp_rope_node_t* right);
+        cdp_rope_node_t* join(cdp_rope_node_t* left,
+                cdp_rope_node_t* right);
+        void split(cdp_rope_node_t* node, const uint64_t position,
+                cdp_rope_node_t** left, cdp_rope_node_t** right);
+        bool insert_in_chunk(cdp_rope_node_t* node, const uint64_t position,
+                const uint8_t* data_in, const size_t data_in_len);
+        void write_node(cdp_rope_node_t* node, const uint64_t position,
+                const uint8_t* data_in, const size_t data_in_len);
+        void read_node(cdp_rope_node_t* node, const uint64_t position,
+                const uint64_t len, uint8_t level, uint8_t* data_out);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_ROPE_H_ */
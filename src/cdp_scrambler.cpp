@@ -0,0 +1,369 @@
+/**
+ * @file    cdp_scrambler.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * LFSR scrambler fused with Conditional DePhase encode and decode.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_scrambler.h"
+#include "cdp_linecode.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Multiply a 64 bits vector by a GF(2) matrix stored as 8 tables
+  * (one for each byte of the vector, with the xor of the matrix columns
+  * selected by each byte value).
+  * @param  table Matrix tables.
+  * @param  word Vector to multiply.
+  * @return Product vector.
+  */
+static inline uint64_t TABLE_PRODUCT(const uint64_t table[8][256],
+        const uint64_t word)
+{
+    return (table[0][word & 0xFF] ^ table[1][(word >> 8) & 0xFF] ^
+            table[2][(word >> 16) & 0xFF] ^ table[3][(word >> 24) & 0xFF] ^
+            table[4][(word >> 32) & 0xFF] ^ table[5][(word >> 40) & 0xFF] ^
+            table[6][(word >> 48) & 0xFF] ^ table[7][word >> 56]);
+}
+
+/**
+  * @brief  Get the number of bits of a block of up to 8 bytes.
+  * @param  len Number of bytes left.
+  * @return Number of bytes of the block (up to 8).
+  */
+static inline uint8_t BLOCK_LEN(const size_t len)
+{   return (len < 8) ? (uint8_t)len : 8;   }
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPScrambler constructor */
+CDPScrambler::CDPScrambler()
+{
+    this->type = SCRAMBLER_ADDITIVE;
+    this->polynomial = 0;
+    this->history = 0;
+    memset(this->jump_table, 0, sizeof(this->jump_table));
+    memset(this->impulse_table, 0, sizeof(this->impulse_table));
+}
+
+/* CDPScrambler destructor */
+CDPScrambler::~CDPScrambler()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup the scrambler type, polynomial and initial state, and
+  * precompute its jump tables: the next 64 LFSR bits as a linear function
+  * of the last 64 bits (LFSR state), and for the self-synchronizing type
+  * also the LFSR response to each data bit of a 64 bits block.
+  * @param  type Scrambler type (SCRAMBLER_ADDITIVE or SCRAMBLER_SELF_SYNC).
+  * @param  polynomial LFSR polynomial (bit t set for the x^t term, x^0
+  * implicit; i.e. 0x90 for x^7 + x^4 + 1).
+  * @param  seed LFSR initial state (bit j is the (j+1)-th last bit).
+  * @return Setup result ok (true/false).
+  */
+bool CDPScrambler::setup(const uint8_t type, const uint64_t polynomial,
+        const uint64_t seed)
+{
+    const uint64_t taps = polynomial & ~1ULL;
+    uint64_t columns[64];
+    uint64_t impulse = 0;
+
+    if((type > SCRAMBLER_SELF_SYNC) || (taps == 0))
+        return false;
+
+    this->type = type;
+    this->polynomial = taps;
+    this->history = 0;
+    for(uint8_t j = 0; j < 64; j++)
+        this->history |= ((seed >> j) & 0x01) << (63 - j);
+
+    // LFSR bits of a block from each bit of the last block
+    for(uint8_t i = 0; i < 64; i++)
+    {
+        const uint64_t last = 1ULL << i;
+        columns[i] = 0;
+        for(int8_t n = 0; n < 64; n++)
+        {
+            uint64_t bit = 0;
+            for(uint64_t t = taps; t != 0; t = t & (t - 1))
+            {
+                int8_t k = n - ctz64(t);
+                bit = bit ^ ((k >= 0) ? (columns[i] >> k) : (last >> (64 + k)));
+            }
+            columns[i] = columns[i] | ((bit & 0x01) << n);
+        }
+    }
+
+    // LFSR response to the first data bit of a block (self-synchronizing)
+    for(int8_t n = 0; n < 64; n++)
+    {
+        uint64_t bit = (n == 0);
+        for(uint64_t t = taps; t != 0; t = t & (t - 1))
+        {
+            int8_t k = n - ctz64(t);
+            if(k >= 0)
+                bit = bit ^ (impulse >> k);
+        }
+        impulse = impulse | ((bit & 0x01) << n);
+    }
+
+    for(uint8_t b = 0; b < 8; b++)
+    {
+        for(uint16_t v = 0; v < 256; v++)
+        {
+            this->jump_table[b][v] = 0;
+            this->impulse_table[b][v] = 0;
+            for(uint8_t i = 0; i < 8; i++)
+            {
+                if(((v >> i) & 0x01) == 0)
+                    continue;
+                this->jump_table[b][v] ^= columns[8*b + i];
+                this->impulse_table[b][v] ^= impulse << (8*b + i);
+            }
+        }
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Scramble Methods */
+
+/**
+  * @brief  Scramble data (bits in line order, LSb of each byte first).
+  * @param  data_in Pointer to data to scramble.
+  * @param  data_in_len Number of bytes of data.
+  * @param  data_out Pointer to output data array (can be data_in).
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @return Scramble result ok (true/false).
+  */
+bool CDPScrambler::scramble(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len)
+{
+    if((this->polynomial == 0) || (data_in_len > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = BLOCK_LEN(data_in_len - i);
+        store_le64_len(data_out + i, this->scramble_word(
+                load_le64_len(data_in + i, len), len*8), len);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Descramble data (bits in line order, LSb of each byte first).
+  * @param  data_in Pointer to data to descramble.
+  * @param  data_in_len Number of bytes of data.
+  * @param  data_out Pointer to output data array (can be data_in).
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @return Descramble result ok (true/false).
+  */
+bool CDPScrambler::descramble(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len)
+{
+    if((this->polynomial == 0) || (data_in_len > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = BLOCK_LEN(data_in_len - i);
+        store_le64_len(data_out + i, this->descramble_word(
+                load_le64_len(data_in + i, len), len*8), len);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Scramble and encode data in the same pass (64 bits at once, as
+  * CDP::encode() output of the scrambled data).
+  * @param  data_in Pointer to input data to be encode.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @param  data_out Pointer to output data array to store the encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Encode result ok (true/false).
+  */
+bool CDPScrambler::encode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    if((this->polynomial == 0) || (data_in_len*2 > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = BLOCK_LEN(data_in_len - i);
+        uint64_t data = this->scramble_word(load_le64_len(data_in + i, len),
+                len*8);
+        uint8_t low_len = (len < 4) ? len : 4;
+
+        store_le64_len(data_out + i*2, CDPDiffManchester::ENCODE_BITS(
+                (uint32_t)data, low_len*8, current_signal_level), low_len*2);
+        if(len > 4)
+        {
+            store_le64_len(data_out + i*2 + 8, CDPDiffManchester::ENCODE_BITS(
+                    (uint32_t)(data >> 32), (len - 4)*8,
+                    current_signal_level), (len - 4)*2);
+        }
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Decode and descramble data in the same pass (64 bits at once).
+  * @param  data_in Pointer to encoded input data to be decoded.
+  * @param  data_in_len Number of bytes to decode from input data (even).
+  * @param  data_out Pointer to output data array to store the decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Decode result ok (true/false).
+  */
+bool CDPScrambler::decode(const uint8_t* data_in, const size_t data_in_len,
+        uint8_t* data_out, const size_t data_out_len,
+        uint8_t* current_signal_level)
+{
+    if((this->polynomial == 0) || (data_in_len % 2 != 0) ||
+       (data_in_len/2 > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len/2; i = i + 8)
+    {
+        uint8_t len = BLOCK_LEN(data_in_len/2 - i);
+        uint8_t low_len = (len < 4) ? len : 4;
+        uint64_t data = CDPDiffManchester::DECODE_CHIPS(load_le64_len(
+                data_in + i*2, low_len*2), low_len*8, current_signal_level);
+
+        if(len > 4)
+        {
+            data = (data & 0xFFFFFFFFULL) |
+                    ((uint64_t)CDPDiffManchester::DECODE_CHIPS(load_le64_len(
+                    data_in + i*2 + 8, (len - 4)*2), (len - 4)*8,
+                    current_signal_level) << 32);
+        }
+        if(len < 8)
+            data = data & ((1ULL << (len*8)) - 1);
+        store_le64_len(data_out + i, this->descramble_word(data, len*8), len);
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Scramble a block of up to 64 bits. The LFSR bits of the block
+  * are the jump tables product of the last 64 bits, plus (self
+  * synchronizing) the response to the block data bits.
+  * @param  data Data bits (line order).
+  * @param  num_bits Number of bits of the block (1 to 64).
+  * @return Scrambled bits.
+  */
+uint64_t CDPScrambler::scramble_word(const uint64_t data,
+        const uint8_t num_bits)
+{
+    uint64_t bits = TABLE_PRODUCT(this->jump_table, this->history);
+
+    if(this->type == SCRAMBLER_ADDITIVE)
+    {
+        this->update_history(bits, num_bits);
+        return data ^ bits;
+    }
+
+    bits = bits ^ TABLE_PRODUCT(this->impulse_table, data);
+    this->update_history(bits, num_bits);
+    return bits;
+}
+
+/**
+  * @brief  Descramble a block of up to 64 bits (self-synchronizing
+  * descramble is not recursive: each data bit is the xor of a scrambled bit
+  * with the scrambled bits at the taps distances before it).
+  * @param  data Scrambled bits (line order).
+  * @param  num_bits Number of bits of the block (1 to 64).
+  * @return Descrambled bits.
+  */
+uint64_t CDPScrambler::descramble_word(const uint64_t data,
+        const uint8_t num_bits)
+{
+    uint64_t bits = data;
+
+    if(this->type == SCRAMBLER_ADDITIVE)
+        return this->scramble_word(data, num_bits);
+
+    for(uint64_t t = this->polynomial; t != 0; t = t & (t - 1))
+    {
+        uint8_t shift = ctz64(t);
+        bits = bits ^ ((data << shift) | (this->history >> (64 - shift)));
+    }
+    this->update_history(data, num_bits);
+    return bits;
+}
+
+/**
+  * @brief  Add the last bits to the LFSR state (last 64 bits).
+  * @param  bits New bits (line order).
+  * @param  num_bits Number of new bits (1 to 64).
+  */
+void CDPScrambler::update_history(const uint64_t bits,
+        const uint8_t num_bits)
+{
+    if(num_bits >= 64)
+        this->history = bits;
+    else
+        this->history = (this->history >> num_bits) |
+                (bits << (64 - num_bits));
+}
@@ -0,0 +1,105 @@
+/**
+ * @file    cdp_scrambler.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * LFSR scrambler (additive or self-synchronizing, with any polynomial up
+ * to degree 63) fused with Conditional DePhase encode and decode, that
+ * scrambles 64 bits at each step with precomputed jump tables.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_SCRAMBLER_H_
+#define CDP_SCRAMBLER_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Scrambler types:
+//   Additive: data is xored with the LFSR sequence (both ends need the
+//     same seed at the same point of the stream).
+//   Self-synchronizing: the LFSR is fed with the scrambled bits, so the
+//     descrambler synchronizes itself after degree bits.
+#define SCRAMBLER_ADDITIVE  0
+#define SCRAMBLER_SELF_SYNC 1
+
+// Highest polynomial degree
+#define SCRAMBLER_MAX_DEGREE 63
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPScrambler
+{
+    public:
+
+        CDPScrambler();
+        ~CDPScrambler();
+
+        bool setup(const uint8_t type, const uint64_t polynomial,
+                const uint64_t seed);
+
+        bool scramble(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len);
+        bool descramble(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len);
+
+        bool encode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool decode(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+
+    private:
+
+        uint8_t type;
+        uint64_t polynomial;
+        uint64_t history;
+        uint64_t jump_table[8][256];
+        uint64_t impulse_table[8][256];
+
+        uint64_t scramble_word(const uint64_t data, const uint8_t num_bits);
+        uint64_t descramble_word(const uint64_t data,
+                const uint8_t num_bits);
+        void update_history(const uint64_t bits, const uint8_t num_bits);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_SCRAMBLER_H_ */
@@ -0,0 +1,196 @@
+/**
+ * @file    cdp_search.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Data pattern search in encoded streams.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_search.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// First chip of the pattern (its value is given by the level before it)
+#define FIRST_CHIP_MASK 0x01
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPPatternSearch constructor */
+CDPPatternSearch::CDPPatternSearch()
+{
+    this->chips_len = 0;
+}
+
+/* CDPPatternSearch destructor */
+CDPPatternSearch::~CDPPatternSearch()
+{}
+
+/*****************************************************************************/
+
+/* Search Methods */
+
+/**
+  * @brief  Set the data pattern to look for, encoding it for both signal
+  * levels before it.
+  * @param  pattern Pointer to data pattern.
+  * @param  pattern_len Number of bytes of the data pattern (1 to
+  * SEARCH_MAX_PATTERN_LEN).
+  * @return Setup result ok (true/false).
+  */
+bool CDPPatternSearch::setup(const uint8_t* pattern, const size_t pattern_len)
+{
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    if((pattern_len == 0) || (pattern_len > SEARCH_MAX_PATTERN_LEN))
+        return false;
+
+    this->Cdp.encode(pattern, pattern_len, this->chips_high,
+            sizeof(this->chips_high), &level);
+    copy_not(this->chips_low, this->chips_high, pattern_len*2);
+    this->chips_len = pattern_len*2;
+
+    return true;
+}
+
+/**
+  * @brief  Find the data pattern in an encoded stream (data bytes aligned,
+  * as encode() output). Candidate positions are the ones where the chips of
+  * the first pattern bytes (after its first chip) match any of the two
+  * levels, checked 16 encoded bytes at once; then the chips of the whole
+  * pattern are compared for the level before each candidate.
+  * @param  chips Pointer to encoded stream.
+  * @param  chips_len Number of bytes of the encoded stream.
+  * @param  start_signal_level Signal level before the encoded stream.
+  * @param  start_position Data byte position to start looking from.
+  * @param  matches Pointer to array to store data byte positions of the
+  * pattern found.
+  * @param  matches_len Number of elements of the matches array.
+  * @return Number of matches found (the search stops if the array gets
+  * full, and can continue from the position after the last match).
+  */
+size_t CDPPatternSearch::find(const uint8_t* chips, const size_t chips_len,
+        const uint8_t start_signal_level, const size_t start_position,
+        size_t* matches, const size_t matches_len)
+{
+    size_t num_found = 0;
+    size_t i = start_position*2;
+    size_t last = 0;
+
+    if((this->chips_len == 0) || (chips_len < this->chips_len))
+        return 0;
+    last = chips_len - this->chips_len;
+
+    #if defined(__SSE2__)
+        const uint8_t* high = this->chips_high;
+        const uint8_t* low = this->chips_low;
+        const size_t anchor_len = (this->chips_len > 2) ? 4 : 2;
+
+        // Chips of the first two pattern bytes (second chips byte of each)
+        const __m128i high_a = _mm_set1_epi8((char)high[1]);
+        const __m128i low_a = _mm_set1_epi8((char)low[1]);
+        const __m128i high_b = _mm_set1_epi8((char)high[anchor_len - 1]);
+        const __m128i low_b = _mm_set1_epi8((char)low[anchor_len - 1]);
+        while(i + anchor_len + 15 < chips_len)
+        {
+            __m128i block_a = _mm_loadu_si128((const __m128i*)(chips + i + 1));
+            __m128i block_b = _mm_loadu_si128((const __m128i*)(chips + i +
+                    anchor_len - 1));
+            __m128i found_high = _mm_and_si128(
+                    _mm_cmpeq_epi8(block_a, high_a),
+                    _mm_cmpeq_epi8(block_b, high_b));
+            __m128i found_low = _mm_and_si128(
+                    _mm_cmpeq_epi8(block_a, low_a),
+                    _mm_cmpeq_epi8(block_b, low_b));
+            uint32_t found = (uint32_t)_mm_movemask_epi8(
+                    _mm_or_si128(found_high, found_low)) & 0x5555;
+
+            while(found != 0)
+            {
+                size_t position = i + ctz64(found);
+                uint8_t level = (position == 0) ? start_signal_level :
+                        ((chips[position - 1] >> 7) & 0x01);
+                if(position > last)
+                    return num_found;
+                if(this->match(chips + position, level))
+                {
+                    if(num_found >= matches_len)
+                        return num_found;
+                    matches[num_found] = position / 2;
+                    num_found = num_found + 1;
+                }
+                found = found & (found - 1);
+            }
+            i = i + 16;
+        }
+    #endif
+
+    for(; i <= last; i = i + 2)
+    {
+        uint8_t level = (i == 0) ? start_signal_level :
+                ((chips[i - 1] >> 7) & 0x01);
+        if(this->match(chips + i, level))
+        {
+            if(num_found >= matches_len)
+                return num_found;
+            matches[num_found] = i / 2;
+            num_found = num_found + 1;
+        }
+    }
+
+    return num_found;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Compare the encoded pattern with a position of an encoded
+  * stream. The first chip is not compared, the first pattern bit is given
+  * by the level before it (the transition or not at the bit start).
+  * @param  chips Pointer to the position of the encoded stream.
+  * @param  level Signal level before the position.
+  * @return Pattern found (true/false).
+  */
+bool CDPPatternSearch::match(const uint8_t* chips, const uint8_t level)
+{
+    const uint8_t* pattern = (level == LOGIC_LEVEL_HIGH) ? this->chips_high :
+            this->chips_low;
+
+    if(((chips[0] ^ pattern[0]) & ~FIRST_CHIP_MASK) != 0)
+        return false;
+    return (memcmp(chips + 1, pattern + 1, this->chips_len - 1) == 0);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file    cdp_search.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Data pattern search in encoded streams, that finds where a decoded byte
+ * pattern (i.e. an address or a protocol signature) is in a capture
+ * comparing its encoded chips, without decoding the capture.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_SEARCH_H_
+#define CDP_SEARCH_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Longest data pattern
+#define SEARCH_MAX_PATTERN_LEN 256
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPPatternSearch
+{
+    public:
+
+        CDPPatternSearch();
+        ~CDPPatternSearch();
+
+        bool setup(const uint8_t* pattern, const size_t pattern_len);
+        size_t find(const uint8_t* chips, const size_t chips_len,
+                const uint8_t start_signal_level, const size_t start_position,
+                size_t* matches, const size_t matches_len);
+
+    private:
+
+        CDP Cdp;
+        uint8_t chips_high[SEARCH_MAX_PATTERN_LEN*2];
+        uint8_t chips_low[SEARCH_MAX_PATTERN_LEN*2];
+        size_t chips_len;
+
+        bool match(const uint8_t* chips, const uint8_t level);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_SEARCH_H_ */
@@ -0,0 +1,342 @@
+/**
+ * @file    cdp_stream.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Streaming Conditional DePhase (Differential Manchester) decoder.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_stream.h"
+#include "cdp_bits.h"
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPStreamDecoder constructor */
+CDPStreamDecoder::CDPStreamDecoder()
+{
+    this->crc = NULL;
+    this->setup(NULL, 0, NULL, NULL);
+}
+
+/* CDPStreamDecoder destructor */
+CDPStreamDecoder::~CDPStreamDecoder()
+{}
+
+/*****************************************************************************/
+
+/* Setup Methods */
+
+/**
+  * @brief  Setup decoder output and reset the decode state.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with the decoded data each time the
+  * output array gets full and at flush (NULL to just fill the output array
+  * once, reporting overflow when it gets full).
+  * @param  callback_arg User argument for the callback.
+  */
+void CDPStreamDecoder::setup(uint8_t* data_out, const size_t data_out_len,
+        cdp_stream_cb callback, void* callback_arg)
+{
+    this->data_out = data_out;
+    this->data_out_len = data_out_len;
+    this->callback = callback;
+    this->callback_arg = callback_arg;
+    this->reset();
+}
+
+/**
+  * @brief  Reset decode state to start of stream (signal level to
+  * INITIAL_SIGNAL_LEVEL and first chip of a bit expected), and the CRC
+  * register if any.
+  */
+void CDPStreamDecoder::reset(void)
+{
+    this->data_out_i = 0;
+    this->current_signal_level = INITIAL_SIGNAL_LEVEL;
+    this->chip_phase = 0;
+    this->first_chip = 0;
+    this->decoded_byte = 0x00;
+    this->decoded_bits = 0;
+    this->decoded_total = 0;
+    this->overflow = false;
+    this->crc_word = 0;
+    this->crc_word_len = 0;
+    if(this->crc != NULL)
+        this->crc->reset();
+}
+
+/**
+  * @brief  Set a CRC to update with the decoded bytes as they are decoded
+  * (8 bytes at once, while they are still in a register). Pending bytes
+  * are given to the CRC at resync() and flush(), so the CRC value or FCS
+  * check of a frame can be got from the CRC object after resync() at its
+  * end (the CRC must then be reset by the caller before the next frame).
+  * @param  crc Pointer to the CRC (NULL to stop updating it).
+  */
+void CDPStreamDecoder::set_crc(CDPCrc* crc)
+{
+    this->crc_flush();
+    this->crc = crc;
+    this->crc_word = 0;
+    this->crc_word_len = 0;
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Push one recovered chip to the decoder. Each pair of chips is
+  * decoded with the same rules as CDP::decode_bit() ("10" -> bit equal to
+  * current signal level, signal goes LOW; any other pair -> bit equal to
+  * not(current signal level), signal goes HIGH).
+  * @param  chip Chip logic level (0 or 1).
+  * @return Push result ok (true/false on output overflow).
+  */
+bool CDPStreamDecoder::push_chip(const uint8_t chip)
+{
+    uint8_t new_signal_level = LOGIC_LEVEL_HIGH;
+    uint8_t data_bit = 0x00;
+
+    // Store first chip of the bit and wait for the second one
+    if(this->chip_phase == 0)
+    {
+        this->first_chip = chip;
+        this->chip_phase = 1;
+        return true;
+    }
+    this->chip_phase = 0;
+
+    // Decode the bit
+    if((this->first_chip == 1) && (chip == 0))
+        new_signal_level = LOGIC_LEVEL_LOW;
+    data_bit = new_signal_level ^ this->current_signal_level;
+    this->current_signal_level = new_signal_level;
+
+    // Add decoded bit data (LSb bit first) and output complete bytes
+    this->decoded_byte = this->decoded_byte | (data_bit << this->decoded_bits);
+    this->decoded_bits = this->decoded_bits + 1;
+    if(this->decoded_bits < 8)
+        return true;
+    data_bit = this->decoded_byte;
+    this->decoded_byte = 0x00;
+    this->decoded_bits = 0;
+    this->crc_add(data_bit, 1);
+    return this->output_byte(data_bit);
+}
+
+/**
+  * @brief  Push a run of chips with the same logic level to the decoder.
+  * @param  level Chips logic level (0 or 1).
+  * @param  num_chips Number of chips of the run.
+  * @return Push result ok (true/false on output overflow).
+  */
+bool CDPStreamDecoder::push_run(const uint8_t level, size_t num_chips)
+{
+    while(num_chips > 0)
+    {
+        if(this->push_chip(level) == false)
+            return false;
+        num_chips = num_chips - 1;
+    }
+    return true;
+}
+
+/**
+  * @brief  Push packed chips to the decoder (LSB-first bitstream, same
+  * layout as CDP::encode() output). When the decoder is aligned to a byte
+  * boundary, 64 chips are decoded at once into 4 bytes: even chips and odd
+  * chips are gathered in two words and all the bits are decoded in parallel.
+  * On output overflow the decode state is left as the chip by chip path
+  * does: the chips of the byte (or 64 chips word) that overflowed are
+  * consumed, and the signal level is the one after them.
+  * @param  chips Pointer to packed chips.
+  * @param  num_chips Number of chips to push.
+  * @return Push result ok (true/false on output overflow).
+  */
+bool CDPStreamDecoder::push_chips(const uint8_t* chips, const size_t num_chips)
+{
+    size_t i = 0;
+
+    // Word-parallel decode while aligned to data bytes
+    if((this->chip_phase == 0) && (this->decoded_bits == 0))
+    {
+        uint32_t prev_signal_level = this->current_signal_level;
+        while(i + 64 <= num_chips)
+        {
+            uint64_t word = load_le64(chips + (i / 8));
+            uint32_t first_chips = compress_even64(word);
+            uint32_t second_chips = compress_even64(word >> 1);
+            uint32_t levels = ~(first_chips & ~second_chips);
+            uint32_t data_bits = levels ^ ((levels << 1) | prev_signal_level);
+            prev_signal_level = levels >> 31;
+
+            this->crc_add(data_bits, 4);
+            this->current_signal_level = (uint8_t)prev_signal_level;
+            for(uint8_t n = 0; n < 4; n++)
+            {
+                if(this->output_byte((uint8_t)(data_bits >> (8*n))) == false)
+                    return false;
+            }
+            i = i + 64;
+        }
+    }
+
+    // Remaining chips
+    for(; i < num_chips; i++)
+    {
+        if(this->push_chip((chips[i / 8] >> (i % 8)) & 0x01) == false)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Resynchronize the decoder at the end of a frame (i.e. when the
+  * line goes idle). A bit with just its first chip received is completed
+  * with a chip of given level, the bits of an incomplete byte are dropped
+  * and the signal level goes back to INITIAL_SIGNAL_LEVEL, so next chip is
+  * taken as the first chip of a new frame.
+  * @param  level Logic level of the line at the end of the frame.
+  * @return Resync result ok (true/false on output overflow).
+  */
+bool CDPStreamDecoder::resync(const uint8_t level)
+{
+    bool result = true;
+
+    if(this->chip_phase == 1)
+        result = this->push_chip(level);
+    this->current_signal_level = INITIAL_SIGNAL_LEVEL;
+    this->chip_phase = 0;
+    this->decoded_byte = 0x00;
+    this->decoded_bits = 0;
+    this->crc_flush();
+
+    return result;
+}
+
+/**
+  * @brief  Flush decoded bytes pending in the output array to the callback
+  * (if any). Bits of an incomplete byte are kept in the decoder.
+  * @return Flush result ok (true/false if some output overflow happened).
+  */
+bool CDPStreamDecoder::flush(void)
+{
+    this->crc_flush();
+    if((this->callback != NULL) && (this->data_out_i > 0))
+    {
+        this->callback(this->data_out, this->data_out_i, this->callback_arg);
+        this->data_out_i = 0;
+    }
+    return !(this->overflow);
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get number of decoded bytes currently stored in the output array */
+size_t CDPStreamDecoder::get_decoded_len(void)
+{   return this->data_out_i;   }
+
+/* Get total number of decoded bytes since last reset */
+uint64_t CDPStreamDecoder::get_decoded_total(void)
+{   return this->decoded_total;   }
+
+/* Get if the output array got full without callback to empty it */
+bool CDPStreamDecoder::get_overflow(void)
+{   return this->overflow;   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Store a decoded byte in the output array, calling the output
+  * callback first if the array is full.
+  * @param  data_byte Decoded byte.
+  * @return Store result ok (true/false on output overflow).
+  */
+bool CDPStreamDecoder::output_byte(const uint8_t data_byte)
+{
+    if(this->data_out_i >= this->data_out_len)
+    {
+        if((this->callback == NULL) || (this->data_out_len == 0))
+        {
+            this->overflow = true;
+            return false;
+        }
+        this->callback(this->data_out, this->data_out_i, this->callback_arg);
+        this->data_out_i = 0;
+    }
+    this->data_out[this->data_out_i] = data_byte;
+    this->data_out_i = this->data_out_i + 1;
+    this->decoded_total = this->decoded_total + 1;
+    return true;
+}
+
+/**
+  * @brief  Add decoded bytes to the CRC word, updating the CRC each time
+  * the word gets 8 bytes.
+  * @param  data Decoded bytes (first byte in the low bits).
+  * @param  num_bytes Number of bytes (1 to 8).
+  */
+void CDPStreamDecoder::crc_add(const uint64_t data, const uint8_t num_bytes)
+{
+    uint8_t space = 8 - this->crc_word_len;
+
+    if(this->crc == NULL)
+        return;
+
+    this->crc_word = this->crc_word | (data << (8*this->crc_word_len));
+    if(num_bytes < space)
+    {
+        this->crc_word_len = this->crc_word_len + num_bytes;
+        return;
+    }
+    this->crc->update_word(this->crc_word, 8);
+    this->crc_word = (space < 8) ? (data >> (8*space)) : 0;
+    this->crc_word_len = num_bytes - space;
+}
+
+/**
+  * @brief  Give the bytes pending in the CRC word to the CRC.
+  */
+void CDPStreamDecoder::crc_flush(void)
+{
+    if((this->crc != NULL) && (this->crc_word_len > 0))
+        this->crc->update_word(this->crc_word, this->crc_word_len);
+    this->crc_word = 0;
+    this->crc_word_len = 0;
+}
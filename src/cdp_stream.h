@@ -0,0 +1,112 @@
+/**
+ * @file    cdp_stream.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Streaming Conditional DePhase (Differential Manchester) decoder. It
+ * accepts recovered chips in any amount per call (single chips, runs of
+ * equal chips or packed chips) and keeps the decode state between calls,
+ * so captures can be decoded piece by piece with constant memory.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_STREAM_H_
+#define CDP_STREAM_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp_crc.h"
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Output callback, called with decoded bytes each time the output buffer
+   gets full and at flush */
+typedef void (*cdp_stream_cb)(const uint8_t* data, const size_t data_len,
+        void* arg);
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPStreamDecoder
+{
+    public:
+
+        CDPStreamDecoder();
+        ~CDPStreamDecoder();
+
+        void setup(uint8_t* data_out, const size_t data_out_len,
+                cdp_stream_cb callback, void* callback_arg);
+        void reset(void);
+        void set_crc(CDPCrc* crc);
+
+        bool push_chip(const uint8_t chip);
+        bool push_run(const uint8_t level, size_t num_chips);
+        bool push_chips(const uint8_t* chips, const size_t num_chips);
+        bool resync(const uint8_t level);
+        bool flush(void);
+
+        size_t get_decoded_len(void);
+        uint64_t get_decoded_total(void);
+        bool get_overflow(void);
+
+    private:
+
+        uint8_t* data_out;
+        size_t data_out_len;
+        size_t data_out_i;
+        cdp_stream_cb callback;
+        void* callback_arg;
+
+        uint8_t current_signal_level;
+        uint8_t chip_phase;
+        uint8_t first_chip;
+        uint8_t decoded_byte;
+        uint8_t decoded_bits;
+        uint64_t decoded_total;
+        bool overflow;
+
+        CDPCrc* crc;
+        uint64_t crc_word;
+        uint8_t crc_word_len;
+
+        bool output_byte(const uint8_t data_byte);
+        void crc_add(const uint64_t data, const uint8_t num_bytes);
+        void crc_flush(void);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_STREAM_H_ */
@@ -0,0 +1,250 @@
+/**
+ * @file    cdp_template.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) frame templates.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_template.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Bytes of field changes processed at once for the CRC update
+#define TEMPLATE_DELTA_BLOCK_SIZE 64
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPFrameTemplate constructor */
+CDPFrameTemplate::CDPFrameTemplate()
+{
+    this->num_fields = 0;
+    this->frame_len = 0;
+    this->fcs = 0;
+}
+
+/* CDPFrameTemplate destructor */
+CDPFrameTemplate::~CDPFrameTemplate()
+{}
+
+/*****************************************************************************/
+
+/* Template Methods */
+
+/**
+  * @brief  Compile a frame template: the frame is built and encoded (for a
+  * HIGH starting level) with the given fields values as default, and the
+  * CRC operators for each variable field are computed.
+  * @param  ac Access control field.
+  * @param  fc Frame control field.
+  * @param  da Pointer to destination address (FRAME_ADDR_LEN bytes).
+  * @param  sa Pointer to source address (FRAME_ADDR_LEN bytes).
+  * @param  payload Pointer to frame payload (information field).
+  * @param  payload_len Number of bytes of the payload.
+  * @param  fields Pointer to variable fields array (in offset order, not
+  * overlapped, from AC to the end of the payload).
+  * @param  num_fields Number of variable fields.
+  * @return Compile result ok (true/false).
+  */
+bool CDPFrameTemplate::compile(const uint8_t ac, const uint8_t fc,
+        const uint8_t* da, const uint8_t* sa, const uint8_t* payload,
+        const size_t payload_len, const cdp_template_field_t* fields,
+        const uint8_t num_fields)
+{
+    uint8_t jk[TEMPLATE_MAX_FRAME_LEN];
+    const size_t fcs_offset = FRAME_PAYLOAD_OFFSET + payload_len;
+    size_t offset = FRAME_AC_OFFSET;
+    uint8_t level = LOGIC_LEVEL_HIGH;
+
+    this->frame_len = 0;
+    if((payload_len > TEMPLATE_MAX_PAYLOAD_LEN) ||
+       (num_fields > TEMPLATE_MAX_FIELDS))
+        return false;
+    for(uint8_t i = 0; i < num_fields; i++)
+    {
+        if((fields[i].len == 0) || (fields[i].offset < offset) ||
+           (fields[i].offset + fields[i].len > fcs_offset))
+            return false;
+        offset = fields[i].offset + fields[i].len;
+    }
+
+    // Encoded frame, and its data
+    this->Frame.build(ac, fc, da, sa, payload, payload_len, this->chips,
+            sizeof(this->chips), &level);
+    this->frame_len = FRAME_OVERHEAD_LEN + payload_len;
+    level = LOGIC_LEVEL_HIGH;
+    this->Cdp.decode_symbols(this->chips, this->frame_len*2, this->data, jk,
+            this->frame_len, &level);
+    this->fcs = (uint32_t)load_le64_len(this->data + fcs_offset,
+            CRC32_FCS_LEN);
+
+    // Fields (the FCS is the last one) and their CRC change operators
+    memcpy(this->fields, fields, num_fields*sizeof(cdp_template_field_t));
+    for(uint8_t i = 0; i < num_fields; i++)
+    {
+        crc32_zeros_matrix(this->crc_matrices[i],
+                fcs_offset - (fields[i].offset + fields[i].len));
+    }
+    this->fields[num_fields].offset = (uint16_t)fcs_offset;
+    this->fields[num_fields].len = CRC32_FCS_LEN;
+    this->num_fields = num_fields;
+
+    return true;
+}
+
+/**
+  * @brief  Encode a frame from the template with new values of its
+  * variable fields. Only the fields and the FCS are encoded; each constant
+  * part is copied from the template, inverted if the level before it is
+  * the opposite of the template one. The FCS is the template FCS changed
+  * by the CRC of each field change moved to the FCS position.
+  * @param  values Pointer to array of pointers to each field value.
+  * @param  data_out Pointer to output data array to store the encoded frame.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (get_encoded_len() bytes needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the frame.
+  * @return Encode result ok (true/false).
+  */
+bool CDPFrameTemplate::send(const uint8_t* const* values, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    uint8_t delta[TEMPLATE_DELTA_BLOCK_SIZE];
+    uint8_t fcs_data[CRC32_FCS_LEN];
+    uint32_t crc_delta = 0;
+    uint32_t crc = 0;
+    uint16_t start = 0;
+    size_t position = 0;
+    uint8_t flip = 0;
+
+    if((this->frame_len == 0) || (this->frame_len*2 > data_out_len))
+        return false;
+
+    for(uint8_t i = 0; i <= this->num_fields; i++)
+    {
+        const cdp_template_field_t* field = &(this->fields[i]);
+
+        // Constant part before the field
+        flip = *current_signal_level ^ this->chip_level(position);
+        if(flip)
+        {
+            copy_not(data_out + position*2, this->chips + position*2,
+                    (field->offset - position)*2);
+        }
+        else
+        {
+            memcpy(data_out + position*2, this->chips + position*2,
+                    (field->offset - position)*2);
+        }
+        *current_signal_level = this->chip_level(field->offset) ^ flip;
+        position = field->offset + field->len;
+
+        // Frame check sequence
+        if(i == this->num_fields)
+        {
+            uint32_t fcs = this->fcs ^ crc_delta;
+            store_le64_len(fcs_data, fcs, CRC32_FCS_LEN);
+            this->Cdp.encode(fcs_data, CRC32_FCS_LEN,
+                    data_out + field->offset*2, CRC32_FCS_LEN*2,
+                    current_signal_level);
+            break;
+        }
+
+        // Field, and the CRC change due to it (AC is not covered, so a
+        // field starting at AC only changes the CRC from FC)
+        this->Cdp.encode(values[i], field->len, data_out + field->offset*2,
+                field->len*2, current_signal_level);
+        start = 0;
+        if(field->offset < FRAME_FC_OFFSET)
+            start = FRAME_FC_OFFSET - field->offset;
+        if(start >= field->len)
+            continue;
+        crc = 0;
+        for(uint16_t j = start; j < field->len;
+                j += TEMPLATE_DELTA_BLOCK_SIZE)
+        {
+            uint16_t block_len = field->len - j;
+            if(block_len > TEMPLATE_DELTA_BLOCK_SIZE)
+                block_len = TEMPLATE_DELTA_BLOCK_SIZE;
+            for(uint16_t k = 0; k < block_len; k++)
+                delta[k] = values[i][j + k] ^ this->data[field->offset + j + k];
+            crc = crc32_update(crc, delta, block_len);
+        }
+        crc_delta = crc_delta ^ crc32_matrix_times(this->crc_matrices[i], crc);
+    }
+
+    // Constant part after the FCS (ED and FS)
+    flip = *current_signal_level ^ this->chip_level(position);
+    if(flip)
+    {
+        copy_not(data_out + position*2, this->chips + position*2,
+                (this->frame_len - position)*2);
+    }
+    else
+    {
+        memcpy(data_out + position*2, this->chips + position*2,
+                (this->frame_len - position)*2);
+    }
+    *current_signal_level = this->chip_level(this->frame_len) ^ flip;
+
+    return true;
+}
+
+/**
+  * @brief  Get the number of bytes of the template encoded frames.
+  * @return Number of bytes of each encoded frame (0 if not compiled).
+  */
+size_t CDPFrameTemplate::get_encoded_len(void)
+{
+    return this->frame_len*2;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Get the template signal level before a byte of the frame (the
+  * last chip of the previous byte).
+  * @param  byte_n Frame byte position.
+  * @return Signal level.
+  */
+uint8_t CDPFrameTemplate::chip_level(const size_t byte_n)
+{
+    if(byte_n == 0)
+        return LOGIC_LEVEL_HIGH;
+    return (this->chips[byte_n*2 - 1] >> 7) & 0x01;
+}
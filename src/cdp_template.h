@@ -0,0 +1,114 @@
+/**
+ * @file    cdp_template.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * IEEE 802.5 (Token Ring) frame templates: a frame is encoded once, and
+ * each send only encodes its variable fields (i.e. AC or sequence numbers)
+ * and the FCS (updated with the CRC change of the fields), while constant
+ * parts are copied, inverted when the level before them is the opposite.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_TEMPLATE_H_
+#define CDP_TEMPLATE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+#include "cdp_crc.h"
+#include "cdp_frame.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Maximum number of variable fields of a template
+#define TEMPLATE_MAX_FIELDS 8
+
+// Longest template frame payload
+#define TEMPLATE_MAX_PAYLOAD_LEN 4096
+
+// Bytes of the longest template frame
+#define TEMPLATE_MAX_FRAME_LEN (FRAME_OVERHEAD_LEN + TEMPLATE_MAX_PAYLOAD_LEN)
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Variable field of a template (offset from the SD, use FRAME_*_OFFSET) */
+typedef struct
+{
+    uint16_t offset;
+    uint16_t len;
+} cdp_template_field_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPFrameTemplate
+{
+    public:
+
+        CDPFrameTemplate();
+        ~CDPFrameTemplate();
+
+        bool compile(const uint8_t ac, const uint8_t fc, const uint8_t* da,
+                const uint8_t* sa, const uint8_t* payload,
+                const size_t payload_len, const cdp_template_field_t* fields,
+                const uint8_t num_fields);
+        bool send(const uint8_t* const* values, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+
+        size_t get_encoded_len(void);
+
+    private:
+
+        CDP Cdp;
+        CDPFrame Frame;
+        uint8_t data[TEMPLATE_MAX_FRAME_LEN];
+        uint8_t chips[TEMPLATE_MAX_FRAME_LEN*2];
+        cdp_template_field_t fields[TEMPLATE_MAX_FIELDS + 1];
+        uint32_t crc_matrices[TEMPLATE_MAX_FIELDS][CRC32_MATRIX_ROWS];
+        uint8_t num_fields;
+        size_t frame_len;
+        uint32_t fcs;
+
+        uint8_t chip_level(const size_t byte_n);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_TEMPLATE_H_ */
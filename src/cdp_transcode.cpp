@@ -0,0 +1,301 @@
+/**
+ * @file    cdp_transcode.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Transcoders between Conditional DePhase and other line codes.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_transcode.h"
+#include "cdp_bits.h"
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/**
+  * @brief  Get the encoded chips of up to 32 bits from the signal levels
+  * after each bit (first chip "not(level)", second chip "level"). Both
+  * Conditional DePhase and NRZI have the same levels sequence for the
+  * same data.
+  * @param  levels Signal levels after each bit (LSb first).
+  * @return Encoded chips (LSB-first, 2 chips for each bit).
+  */
+static inline uint64_t LEVELS_TO_CHIPS(const uint32_t levels)
+{   return (expand_even64(~levels) | (expand_even64(levels) << 1));   }
+
+/**
+  * @brief  Get the signal levels after each bit from up to 32 bits encoded
+  * chips (the second chip of each bit).
+  * @param  chips Encoded chips (LSB-first, 2 chips for each bit).
+  * @return Signal levels after each bit (LSb first).
+  */
+static inline uint32_t CHIPS_TO_LEVELS(const uint64_t chips)
+{   return compress_even64(chips >> 1);   }
+
+/**
+  * @brief  Get the level of the last of a number of bits.
+  * @param  bits Bits word (LSb first).
+  * @param  num_bits Number of bits (1 to 64).
+  * @return Last bit value (0 or 1).
+  */
+static inline uint8_t LAST_BIT(const uint64_t bits, const uint8_t num_bits)
+{   return (uint8_t)((bits >> (num_bits - 1)) & 0x01);   }
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPTranscoder constructor */
+CDPTranscoder::CDPTranscoder()
+{}
+
+/* CDPTranscoder destructor */
+CDPTranscoder::~CDPTranscoder()
+{}
+
+/*****************************************************************************/
+
+/* Manchester Methods */
+
+/**
+  * @brief  Transcode Conditional DePhase encoded data to IEEE 802.3
+  * Manchester (bit 0 as "10" chips and bit 1 as "01" chips), 32 bits at
+  * once: each data bit is the xor of the second chips of the bit and of
+  * the bit before (J/K symbols are not supported).
+  * @param  data_in Pointer to Conditional DePhase encoded data.
+  * @param  data_in_len Number of bytes of encoded data (even).
+  * @param  data_out Pointer to output data array to store the Manchester
+  * encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::cdp_to_manchester(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if((data_in_len % 2 != 0) || (data_in_len > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = (data_in_len - i < 8) ? (uint8_t)(data_in_len - i) : 8;
+        uint64_t levels = load_le64_len(data_in + i, len) & ODD_BITS_MASK_64;
+        uint64_t data = levels ^ ((levels << 2) |
+                ((uint64_t)*current_signal_level << 1));
+        *current_signal_level = LAST_BIT(levels, len*8);
+        store_le64_len(data_out + i, data |
+                ((~data & ODD_BITS_MASK_64) >> 1), len);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Transcode IEEE 802.3 Manchester encoded data to Conditional
+  * DePhase, 32 bits at once: the signal level after each bit is the prefix
+  * xor of the data bits (second chips) with the current signal level.
+  * @param  data_in Pointer to Manchester encoded data.
+  * @param  data_in_len Number of bytes of encoded data (even).
+  * @param  data_out Pointer to output data array to store the Conditional
+  * DePhase encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH), updated to the level at the end of the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::manchester_to_cdp(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if((data_in_len % 2 != 0) || (data_in_len > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = (data_in_len - i < 8) ? (uint8_t)(data_in_len - i) : 8;
+        uint64_t levels = load_le64_len(data_in + i, len) & ODD_BITS_MASK_64;
+
+        // Prefix xor of the second chips (even shifts keep them in place)
+        levels = levels ^ (levels << 2);
+        levels = levels ^ (levels << 4);
+        levels = levels ^ (levels << 8);
+        levels = levels ^ (levels << 16);
+        levels = levels ^ (levels << 32);
+        if(*current_signal_level)
+            levels = levels ^ ODD_BITS_MASK_64;
+        *current_signal_level = LAST_BIT(levels, len*8);
+        store_le64_len(data_out + i, levels |
+                ((~levels & ODD_BITS_MASK_64) >> 1), len);
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* NRZ Methods */
+
+/**
+  * @brief  Transcode Conditional DePhase encoded data to NRZ (a signal
+  * level for each data bit, LSb first), 32 bits at once.
+  * @param  data_in Pointer to Conditional DePhase encoded data.
+  * @param  data_in_len Number of bytes of encoded data (even).
+  * @param  data_out Pointer to output data array to store the NRZ data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len/2 needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH) of the encoded data, updated to the level at the
+  * end of the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::cdp_to_nrz(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if((data_in_len % 2 != 0) || (data_in_len/2 > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = (data_in_len - i < 8) ? (uint8_t)(data_in_len - i) : 8;
+        uint32_t levels = CHIPS_TO_LEVELS(load_le64_len(data_in + i, len));
+        uint32_t data = levels ^ ((levels << 1) | *current_signal_level);
+        *current_signal_level = LAST_BIT(levels, len*4);
+        store_le64_len(data_out + i/2, data, len/2);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Transcode NRZ data to Conditional DePhase, 32 bits at once.
+  * @param  data_in Pointer to NRZ data (a level for each bit, LSb first).
+  * @param  data_in_len Number of bytes of NRZ data.
+  * @param  data_out Pointer to output data array to store the Conditional
+  * DePhase encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len*2 needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH) of the encoded data, updated to the level at the
+  * end of the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::nrz_to_cdp(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 4)
+    {
+        uint8_t len = (data_in_len - i < 4) ? (uint8_t)(data_in_len - i) : 4;
+        uint32_t levels = prefix_xor32((uint32_t)load_le64_len(data_in + i,
+                len));
+        if(*current_signal_level)
+            levels = ~levels;
+        *current_signal_level = LAST_BIT(levels, len*8);
+        store_le64_len(data_out + i*2, LEVELS_TO_CHIPS(levels), len*2);
+    }
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* NRZI Methods */
+
+/**
+  * @brief  Transcode Conditional DePhase encoded data to NRZI (a level
+  * for each bit, that is inverted by 1 bits and kept by 0 bits, LSb
+  * first), 32 bits at once: the NRZI levels are the second chips.
+  * @param  data_in Pointer to Conditional DePhase encoded data.
+  * @param  data_in_len Number of bytes of encoded data (even).
+  * @param  data_out Pointer to output data array to store the NRZI levels.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len/2 needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH) of both codes, updated to the level at the end of
+  * the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::cdp_to_nrzi(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if((data_in_len % 2 != 0) || (data_in_len/2 > data_out_len))
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 8)
+    {
+        uint8_t len = (data_in_len - i < 8) ? (uint8_t)(data_in_len - i) : 8;
+        uint32_t levels = CHIPS_TO_LEVELS(load_le64_len(data_in + i, len));
+        *current_signal_level = LAST_BIT(levels, len*4);
+        store_le64_len(data_out + i/2, levels, len/2);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Transcode NRZI levels to Conditional DePhase, 32 bits at once:
+  * the second chips are the NRZI levels.
+  * @param  data_in Pointer to NRZI levels (LSb first).
+  * @param  data_in_len Number of bytes of NRZI levels.
+  * @param  data_out Pointer to output data array to store the Conditional
+  * DePhase encoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array (data_in_len*2 needed).
+  * @param  current_signal_level Pointer to current logic signal level
+  * value (LOW or HIGH) of both codes, updated to the level at the end of
+  * the data.
+  * @return Transcode result ok (true/false).
+  */
+bool CDPTranscoder::nrzi_to_cdp(const uint8_t* data_in,
+        const size_t data_in_len, uint8_t* data_out,
+        const size_t data_out_len, uint8_t* current_signal_level)
+{
+    if(data_in_len*2 > data_out_len)
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i = i + 4)
+    {
+        uint8_t len = (data_in_len - i < 4) ? (uint8_t)(data_in_len - i) : 4;
+        uint32_t levels = (uint32_t)load_le64_len(data_in + i, len);
+        *current_signal_level = LAST_BIT(levels, len*8);
+        store_le64_len(data_out + i*2, LEVELS_TO_CHIPS(levels), len*2);
+    }
+
+    return true;
+}
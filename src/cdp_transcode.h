@@ -0,0 +1,85 @@
+/**
+ * @file    cdp_transcode.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Transcoders between Conditional DePhase (Differential Manchester) and
+ * other line codes (IEEE 802.3 Manchester, NRZ and NRZI), that convert the
+ * chips and levels directly in a single pass, without a decoded buffer.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_TRANSCODE_H_
+#define CDP_TRANSCODE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPTranscoder
+{
+    public:
+
+        CDPTranscoder();
+        ~CDPTranscoder();
+
+        bool cdp_to_manchester(const uint8_t* data_in,
+                const size_t data_in_len, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+        bool manchester_to_cdp(const uint8_t* data_in,
+                const size_t data_in_len, uint8_t* data_out,
+                const size_t data_out_len, uint8_t* current_signal_level);
+
+        bool cdp_to_nrz(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool nrz_to_cdp(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+
+        bool cdp_to_nrzi(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+        bool nrzi_to_cdp(const uint8_t* data_in, const size_t data_in_len,
+                uint8_t* data_out, const size_t data_out_len,
+                uint8_t* current_signal_level);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_TRANSCODE_H_ */
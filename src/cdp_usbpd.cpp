@@ -0,0 +1,404 @@
+/**
+ * @file    cdp_usbpd.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * USB Power Delivery packets codec (BMC and 4b5b).
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include "cdp_usbpd.h"
+#include "cdp_linecode.h"
+#include "cdp_bits.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+/* Constants */
+
+// 4b5b data symbols of each nibble value
+static const uint8_t NIBBLE_SYMBOLS[16] =
+{
+    0x1E, 0x09, 0x14, 0x15, 0x0A, 0x0B, 0x0E, 0x0F,
+    0x12, 0x13, 0x16, 0x17, 0x1A, 0x1B, 0x1C, 0x1D
+};
+
+// K-codes of each ordered set
+static const uint8_t ORDERED_SETS[PD_NUM_ORDERED_SETS][4] =
+{
+    { PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC2 },
+    { PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC3, PD_SYMBOL_SYNC3 },
+    { PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC3, PD_SYMBOL_SYNC1, PD_SYMBOL_SYNC3 },
+    { PD_SYMBOL_RST1, PD_SYMBOL_RST1, PD_SYMBOL_RST1, PD_SYMBOL_RST2 },
+    { PD_SYMBOL_RST1, PD_SYMBOL_SYNC1, PD_SYMBOL_RST1, PD_SYMBOL_SYNC3 }
+};
+
+// Preamble bits (alternating, starting with 0)
+#define PREAMBLE_BITS 64
+#define PREAMBLE_WORD 0xAAAA
+
+// Chips of each symbol, byte and ordered set
+#define SYMBOL_CHIPS 10
+#define BYTE_CHIPS 20
+#define ORDERED_SET_CHIPS 40
+#define ORDERED_SET_MASK ((1ULL << ORDERED_SET_CHIPS) - 1)
+
+// Symbol values of the chips table (nibbles values are 0 to 15)
+#define SYMBOL_K_CODE 0x10
+#define SYMBOL_INVALID 0xFF
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPUSBPD constructor */
+CDPUSBPD::CDPUSBPD()
+{
+    uint8_t level = LOGIC_LEVEL_LOW;
+
+    // BMC chips of each 5 bits symbol and of each byte (2 symbols, low
+    // nibble first), for LOW level before them
+    for(uint8_t i = 0; i < 32; i++)
+    {
+        level = LOGIC_LEVEL_LOW;
+        this->symbol_chips[i] = (uint16_t)(CDPBiphaseMark::ENCODE_BITS(i, 5,
+                &level) & 0x3FF);
+        this->symbol_parity[i] = level;
+    }
+    for(uint16_t i = 0; i < 256; i++)
+    {
+        uint8_t low = NIBBLE_SYMBOLS[i & 0x0F];
+        uint8_t high = NIBBLE_SYMBOLS[i >> 4];
+        uint32_t high_chips = this->symbol_chips[high];
+        if(this->symbol_parity[low])
+            high_chips = ~high_chips & 0x3FF;
+        this->byte_chips[i] = this->symbol_chips[low] |
+                (high_chips << SYMBOL_CHIPS);
+        this->byte_parity[i] = this->symbol_parity[low] ^
+                this->symbol_parity[high];
+    }
+    for(uint8_t i = 0; i < PD_NUM_ORDERED_SETS; i++)
+    {
+        uint64_t chips = 0;
+        level = LOGIC_LEVEL_LOW;
+        for(uint8_t j = 0; j < 4; j++)
+        {
+            uint64_t k_chips = this->symbol_chips[ORDERED_SETS[i][j]];
+            if(level)
+                k_chips = ~k_chips & 0x3FF;
+            level = level ^ this->symbol_parity[ORDERED_SETS[i][j]];
+            chips = chips | (k_chips << (j*SYMBOL_CHIPS));
+        }
+        this->ordered_set_chips[i] = chips;
+    }
+
+    // Symbol value of each 10 chips (with the transitions at the start of
+    // the second to fifth bits)
+    memset(this->chips_symbol, SYMBOL_INVALID, sizeof(this->chips_symbol));
+    for(uint8_t i = 0; i < 32; i++)
+    {
+        uint8_t value = SYMBOL_INVALID;
+        for(uint8_t j = 0; j < 16; j++)
+        {
+            if(NIBBLE_SYMBOLS[j] == i)
+                value = j;
+        }
+        if((i == PD_SYMBOL_SYNC1) || (i == PD_SYMBOL_SYNC2) ||
+           (i == PD_SYMBOL_SYNC3) || (i == PD_SYMBOL_RST1) ||
+           (i == PD_SYMBOL_RST2) || (i == PD_SYMBOL_EOP))
+            value = SYMBOL_K_CODE | i;
+        this->chips_symbol[this->symbol_chips[i]] = value;
+        this->chips_symbol[~this->symbol_chips[i] & 0x3FF] = value;
+    }
+
+    this->data_out = NULL;
+    this->data_out_i = 0;
+    this->acc = 0;
+    this->acc_bits = 0;
+    this->current_signal_level = LOGIC_LEVEL_LOW;
+}
+
+/* CDPUSBPD destructor */
+CDPUSBPD::~CDPUSBPD()
+{}
+
+/*****************************************************************************/
+
+/* Encode Methods */
+
+/**
+  * @brief  Encode a packet: preamble, ordered set and, for SOP* packets,
+  * the message, its CRC-32 and EOP. Each message byte is mapped to its two
+  * 4b5b symbols BMC chips with a single table lookup (inverted if the
+  * level before it is HIGH).
+  * @param  ordered_set Packet ordered set (PD_SOP ... PD_CABLE_RESET).
+  * @param  message Pointer to message (header and data objects).
+  * @param  message_len Number of bytes of message (0 for resets).
+  * @param  data_out Pointer to output data array to store the chips
+  * (LSB-first, as encode() output; unused chips of last byte are 0).
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  num_chips Pointer to store the number of chips of the packet.
+  * @return Encode result ok (true/false).
+  */
+bool CDPUSBPD::encode(const uint8_t ordered_set, const uint8_t* message,
+        const size_t message_len, uint8_t* data_out,
+        const size_t data_out_len, uint64_t* num_chips)
+{
+    uint8_t crc_bytes[CRC32_FCS_LEN];
+    uint32_t crc = 0;
+
+    // Check packet type and length, and if it doesn't fit in output array
+    if((ordered_set >= PD_NUM_ORDERED_SETS) ||
+       ((ordered_set >= PD_HARD_RESET) && (message_len != 0)) ||
+       ((ordered_set < PD_HARD_RESET) && (message_len == 0)) ||
+       (message_len > PD_MAX_MESSAGE_LEN))
+        return false;
+    *num_chips = this->get_encoded_chips(ordered_set, message_len);
+    if((*num_chips + 7) / 8 > data_out_len)
+        return false;
+
+    this->data_out = data_out;
+    this->data_out_i = 0;
+    this->acc = 0;
+    this->acc_bits = 0;
+    this->current_signal_level = LOGIC_LEVEL_LOW;
+
+    // Preamble and ordered set
+    for(uint8_t i = 0; i < PREAMBLE_BITS / 16; i++)
+    {
+        this->put_chips(CDPBiphaseMark::ENCODE_BITS(PREAMBLE_WORD, 16,
+                &(this->current_signal_level)), 32);
+    }
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        uint8_t symbol = ORDERED_SETS[ordered_set][i];
+        this->put_coded(this->symbol_chips[symbol], SYMBOL_CHIPS,
+                this->symbol_parity[symbol]);
+    }
+
+    // Message, CRC and EOP
+    if(message_len > 0)
+    {
+        crc = crc32_final(crc32_update(CRC32_INIT, message, message_len));
+        store_le64_len(crc_bytes, crc, CRC32_FCS_LEN);
+        for(size_t i = 0; i < message_len; i++)
+        {
+            this->put_coded(this->byte_chips[message[i]], BYTE_CHIPS,
+                    this->byte_parity[message[i]]);
+        }
+        for(uint8_t i = 0; i < CRC32_FCS_LEN; i++)
+        {
+            this->put_coded(this->byte_chips[crc_bytes[i]], BYTE_CHIPS,
+                    this->byte_parity[crc_bytes[i]]);
+        }
+        this->put_coded(this->symbol_chips[PD_SYMBOL_EOP], SYMBOL_CHIPS,
+                this->symbol_parity[PD_SYMBOL_EOP]);
+    }
+    if(this->acc_bits > 0)
+        this->data_out[this->data_out_i] = (uint8_t)this->acc;
+
+    return true;
+}
+
+/*****************************************************************************/
+
+/* Decode Methods */
+
+/**
+  * @brief  Decode the next packet of a chip stream. The ordered set is
+  * looked for at each chip position (both signal levels, with the
+  * transition at its start), and then each 10 chips are mapped to their
+  * 4b5b symbol value with a single table lookup, until EOP.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips of the stream.
+  * @param  start_chip Chip position to start looking from.
+  * @param  packet Pointer to store the decoded packet.
+  * @return Packet found (true/false). Decode can continue from the end
+  * chip of the packet.
+  */
+bool CDPUSBPD::decode(const uint8_t* chips, const uint64_t num_chips,
+        const uint64_t start_chip, cdp_usbpd_packet_t* packet)
+{
+    for(uint64_t chip_n = start_chip; chip_n + ORDERED_SET_CHIPS <= num_chips;
+            chip_n++)
+    {
+        uint64_t word = 0;
+
+        // Check the transition at the start (chip before it is the level,
+        // any level at the stream start)
+        if(chip_n > 0)
+            word = load_chips64(chips, num_chips, chip_n - 1);
+        else
+        {
+            word = load_chips64(chips, num_chips, chip_n) << 1;
+            word = word | (~(word >> 1) & 0x01);
+        }
+        if(((word ^ (word >> 1)) & 0x01) == 0)
+            continue;
+
+        // Normalize to LOW level before (first chip HIGH)
+        word = (word >> 1) & ORDERED_SET_MASK;
+        if((word & 0x01) == 0)
+            word = ~word & ORDERED_SET_MASK;
+
+        for(uint8_t i = 0; i < PD_NUM_ORDERED_SETS; i++)
+        {
+            if(word != this->ordered_set_chips[i])
+                continue;
+
+            packet->start_chip = chip_n;
+            packet->ordered_set = i;
+            packet->message_len = 0;
+            packet->result = PD_RESULT_OK;
+            packet->end_chip = chip_n + ORDERED_SET_CHIPS;
+            if(i < PD_HARD_RESET)
+                this->decode_message(chips, num_chips, packet->end_chip,
+                        packet);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/**
+  * @brief  Get the number of chips of an encoded packet.
+  * @param  ordered_set Packet ordered set (PD_SOP ... PD_CABLE_RESET).
+  * @param  message_len Number of bytes of message (0 for resets).
+  * @return Number of chips.
+  */
+uint64_t CDPUSBPD::get_encoded_chips(const uint8_t ordered_set,
+        const size_t message_len)
+{
+    uint64_t num_chips = PREAMBLE_BITS*2 + ORDERED_SET_CHIPS;
+
+    if(ordered_set < PD_HARD_RESET)
+    {
+        num_chips = num_chips + (message_len + CRC32_FCS_LEN)*BYTE_CHIPS +
+                SYMBOL_CHIPS;
+    }
+    return num_chips;
+}
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Append chips to the output data.
+  * @param  chips Chips to append (LSB-first, upper chips are ignored).
+  * @param  num_chips Number of chips (up to 56).
+  */
+void CDPUSBPD::put_chips(const uint64_t chips, const uint8_t num_chips)
+{
+    this->acc = this->acc |
+            ((chips & ((1ULL << num_chips) - 1)) << this->acc_bits);
+    this->acc_bits = this->acc_bits + num_chips;
+    while(this->acc_bits >= 8)
+    {
+        this->data_out[this->data_out_i] = (uint8_t)this->acc;
+        this->data_out_i = this->data_out_i + 1;
+        this->acc = this->acc >> 8;
+        this->acc_bits = this->acc_bits - 8;
+    }
+}
+
+/**
+  * @brief  Append chips encoded for LOW level before them to the output
+  * data (inverted if the current level is HIGH).
+  * @param  chips Chips for LOW level before them (LSB-first).
+  * @param  num_chips Number of chips (up to 32).
+  * @param  parity Level change of the chips.
+  */
+void CDPUSBPD::put_coded(const uint32_t chips, const uint8_t num_chips,
+        const uint8_t parity)
+{
+    uint64_t level_chips = chips;
+
+    if(this->current_signal_level)
+        level_chips = ~level_chips & ((1ULL << num_chips) - 1);
+    this->current_signal_level = this->current_signal_level ^ parity;
+    this->put_chips(level_chips, num_chips);
+}
+
+/**
+  * @brief  Decode the message symbols after an SOP* ordered set, until
+  * EOP, and check its CRC-32.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips of the stream.
+  * @param  chip_n Chip position of the first message symbol.
+  * @param  packet Pointer to the packet to store the message.
+  */
+void CDPUSBPD::decode_message(const uint8_t* chips, const uint64_t num_chips,
+        uint64_t chip_n, cdp_usbpd_packet_t* packet)
+{
+    uint8_t last_chip = (chips[(chip_n - 1) / 8] >> ((chip_n - 1) % 8)) &
+            0x01;
+    size_t num_nibbles = 0;
+
+    packet->result = PD_RESULT_SYMBOL_ERROR;
+    while(chip_n + SYMBOL_CHIPS <= num_chips)
+    {
+        uint16_t symbol_chips = (uint16_t)(load_chips64(chips, num_chips,
+                chip_n) & 0x3FF);
+        uint8_t value = this->chips_symbol[symbol_chips];
+
+        // Check the transition at the symbol start and the symbol value
+        if((value == SYMBOL_INVALID) || ((symbol_chips & 0x01) == last_chip))
+            break;
+        chip_n = chip_n + SYMBOL_CHIPS;
+        packet->end_chip = chip_n;
+        last_chip = (uint8_t)(symbol_chips >> (SYMBOL_CHIPS - 1));
+        if(value == (SYMBOL_K_CODE | PD_SYMBOL_EOP))
+        {
+            if((num_nibbles % 2 != 0) || (num_nibbles/2 <= CRC32_FCS_LEN))
+                break;
+            packet->message_len = (uint16_t)(num_nibbles/2 - CRC32_FCS_LEN);
+            packet->result = (crc32_update(CRC32_INIT, packet->message,
+                    num_nibbles/2) == CRC32_RESIDUE) ? PD_RESULT_OK :
+                    PD_RESULT_CRC_ERROR;
+            return;
+        }
+        if((value & SYMBOL_K_CODE) ||
+           (num_nibbles >= (PD_MAX_MESSAGE_LEN + CRC32_FCS_LEN)*2))
+            break;
+
+        // Bytes are sent low nibble first
+        if(num_nibbles % 2 == 0)
+            packet->message[num_nibbles/2] = value;
+        else
+            packet->message[num_nibbles/2] |= (uint8_t)(value << 4);
+        num_nibbles = num_nibbles + 1;
+    }
+}
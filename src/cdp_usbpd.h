@@ -0,0 +1,143 @@
+/**
+ * @file    cdp_usbpd.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * USB Power Delivery packets codec: 4b5b symbols carried with biphase
+ * mark code (BMC), with preamble, SOP* / reset ordered sets (K-codes),
+ * CRC-32 and EOP. Encode maps bytes to 4b5b symbols and BMC chips in one
+ * table lookup, and decode maps each 10 chips to a 4b5b symbol value in
+ * one table lookup, finding the ordered sets at any chip position.
+ *
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_USBPD_H_
+#define CDP_USBPD_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp_crc.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// Longest message (header, extended header and data, without CRC)
+#define PD_MAX_MESSAGE_LEN 264
+
+// Ordered sets
+#define PD_SOP              0
+#define PD_SOP_PRIME        1
+#define PD_SOP_DOUBLE_PRIME 2
+#define PD_HARD_RESET       3
+#define PD_CABLE_RESET      4
+#define PD_NUM_ORDERED_SETS 5
+
+// 4b5b K-codes symbols (5 bits values, sent LSb first)
+#define PD_SYMBOL_SYNC1 0x18
+#define PD_SYMBOL_SYNC2 0x11
+#define PD_SYMBOL_SYNC3 0x06
+#define PD_SYMBOL_RST1  0x07
+#define PD_SYMBOL_RST2  0x19
+#define PD_SYMBOL_EOP   0x0D
+
+// Decode results
+#define PD_RESULT_OK           0
+#define PD_RESULT_CRC_ERROR    1
+#define PD_RESULT_SYMBOL_ERROR 2
+
+/*****************************************************************************/
+
+/* Data Types */
+
+/* Decoded packet */
+typedef struct
+{
+    uint64_t start_chip;    // Position of the first chip of the ordered set
+    uint64_t end_chip;      // Position of the chip after the packet
+    uint8_t ordered_set;    // PD_SOP ... PD_CABLE_RESET
+    uint8_t result;         // PD_RESULT_x
+    uint16_t message_len;   // Message bytes (without CRC)
+    uint8_t message[PD_MAX_MESSAGE_LEN + CRC32_FCS_LEN];
+} cdp_usbpd_packet_t;
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPUSBPD
+{
+    public:
+
+        CDPUSBPD();
+        ~CDPUSBPD();
+
+        bool encode(const uint8_t ordered_set, const uint8_t* message,
+                const size_t message_len, uint8_t* data_out,
+                const size_t data_out_len, uint64_t* num_chips);
+        bool decode(const uint8_t* chips, const uint64_t num_chips,
+                const uint64_t start_chip, cdp_usbpd_packet_t* packet);
+
+        static uint64_t get_encoded_chips(const uint8_t ordered_set,
+                const size_t message_len);
+
+    private:
+
+        // Chips for LOW level before them, and their level change
+        uint16_t symbol_chips[32];
+        uint8_t symbol_parity[32];
+        uint32_t byte_chips[256];
+        uint8_t byte_parity[256];
+        uint64_t ordered_set_chips[PD_NUM_ORDERED_SETS];
+
+        // Symbol value (or 0xFF if invalid) of each 10 chips
+        uint8_t chips_symbol[1024];
+
+        // Encoder output state
+        uint8_t* data_out;
+        size_t data_out_i;
+        uint64_t acc;
+        uint8_t acc_bits;
+        uint8_t current_signal_level;
+
+        void put_chips(const uint64_t chips, const uint8_t num_chips);
+        void put_coded(const uint32_t chips, const uint8_t num_chips,
+                const uint8_t parity);
+        void decode_message(const uint8_t* chips, const uint64_t num_chips,
+                uint64_t chip_n, cdp_usbpd_packet_t* packet);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_USBPD_H_ */
@@ -0,0 +1,558 @@
+/**
+ * @file    cdp_wave.cpp
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) PCM WAV waveform synthesis
+ * and soft decision decode.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <string.h>
+
+#include "cdp_wave.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// WAV file header size (RIFF header, 16 bytes "fmt " chunk and "data"
+// chunk header)
+#define WAVE_HEADER_SIZE 44
+
+// Bytes of data encoded on each synthesis step
+#define WAVE_ENCODE_BLOCK_SIZE 64
+
+// Soft decoder timing loop gains and maximum period deviation
+#define WAVE_PHASE_GAIN 0.25
+#define WAVE_FREQ_GAIN 0.03125
+#define WAVE_MAX_DEVIATION 0.125
+
+/*****************************************************************************/
+
+/* In-Scope inline Functions */
+
+/* Store 16 bits value as little-endian bytes */
+static inline void PUT_LE16(uint8_t* data, const uint16_t value)
+{
+    data[0] = (uint8_t)(value & 0xff);
+    data[1] = (uint8_t)((value >> 8) & 0xff);
+}
+
+/* Store 32 bits value as little-endian bytes */
+static inline void PUT_LE32(uint8_t* data, const uint32_t value)
+{
+    PUT_LE16(data, (uint16_t)(value & 0xffff));
+    PUT_LE16(data + 2, (uint16_t)(value >> 16));
+}
+
+/* Get 16 bits value from little-endian bytes */
+static inline uint16_t GET_LE16(const uint8_t* data)
+{   return (uint16_t)(data[0] | (data[1] << 8));   }
+
+/* Get 32 bits value from little-endian bytes */
+static inline uint32_t GET_LE32(const uint8_t* data)
+{
+    return ((uint32_t)GET_LE16(data) | ((uint32_t)GET_LE16(data + 2) << 16));
+}
+
+/*****************************************************************************/
+
+/* Constructor & Destructor */
+
+/* CDPWave constructor */
+CDPWave::CDPWave()
+{
+    this->file = NULL;
+    this->buffer_len = 0;
+    this->sample_rate = 0;
+    this->decoder_setup(1.0, NULL, 0, NULL, NULL);
+}
+
+/* CDPWave destructor */
+CDPWave::~CDPWave()
+{
+    if(this->file != NULL)
+        this->writer_close();
+}
+
+/*****************************************************************************/
+
+/* Synthesis Methods */
+
+/**
+  * @brief  Create a mono WAV file to synthesize encoded data waveforms.
+  * Chips are output as +amplitude (HIGH) or -amplitude (LOW) levels.
+  * @param  file_path Path of the WAV file to create.
+  * @param  sample_rate Samples per second.
+  * @param  format Samples format (WAVE_FORMAT_PCM16 or WAVE_FORMAT_FLOAT32).
+  * @param  samples_per_chip Samples of each chip (1 to
+  * WAVE_MAX_SAMPLES_PER_CHIP).
+  * @param  amplitude Chips amplitude (0.0 to 1.0 of full scale).
+  * @param  rise_samples Samples of the linear ramp between levels at each
+  * signal transition (0 for square waveform, up to samples_per_chip).
+  * @return Open result ok (true/false).
+  */
+bool CDPWave::writer_open(const char* file_path, const uint32_t sample_rate,
+        const uint16_t format, const uint16_t samples_per_chip,
+        const float amplitude, const uint16_t rise_samples)
+{
+    if((format != WAVE_FORMAT_PCM16) && (format != WAVE_FORMAT_FLOAT32))
+        return false;
+    if((samples_per_chip == 0) ||
+       (samples_per_chip > WAVE_MAX_SAMPLES_PER_CHIP) ||
+       (rise_samples > samples_per_chip))
+        return false;
+    if(this->file != NULL)
+        this->writer_close();
+
+    this->file = fopen(file_path, "wb");
+    if(this->file == NULL)
+        return false;
+
+    this->sample_rate = sample_rate;
+    this->format = format;
+    this->sample_size = (format == WAVE_FORMAT_PCM16) ? 2 : 4;
+    this->samples_per_chip = samples_per_chip;
+    this->current_signal_level = INITIAL_SIGNAL_LEVEL;
+    this->first_chip = true;
+    this->data_size = 0;
+    this->build_templates(amplitude, rise_samples);
+
+    // Reserve header space (written with final sizes on close)
+    memset(this->buffer, 0, WAVE_HEADER_SIZE);
+    this->buffer_len = 0;
+    if(fwrite(this->buffer, 1, WAVE_HEADER_SIZE, this->file) !=
+            WAVE_HEADER_SIZE)
+    {
+        fclose(this->file);
+        this->file = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Encode data and append its waveform to the WAV file. It can be
+  * called successive times, the signal continues between calls. Each chip
+  * waveform is copied from a precomputed block in the final sample format
+  * (chosen by previous and current chip levels), so no per sample
+  * computation or conversion is done.
+  * @param  data_in Pointer to input data to be encoded.
+  * @param  data_in_len Number of bytes to encode from input data.
+  * @return Write result ok (true/false).
+  */
+bool CDPWave::write(const uint8_t* data_in, const size_t data_in_len)
+{
+    const size_t chip_size = this->samples_per_chip * this->sample_size;
+    uint8_t chips[WAVE_ENCODE_BLOCK_SIZE*2];
+
+    if(this->file == NULL)
+        return false;
+
+    for(size_t i = 0; i < data_in_len; i += WAVE_ENCODE_BLOCK_SIZE)
+    {
+        size_t block_len = data_in_len - i;
+        if(block_len > WAVE_ENCODE_BLOCK_SIZE)
+            block_len = WAVE_ENCODE_BLOCK_SIZE;
+        this->Cdp.encode(data_in + i, block_len, chips, sizeof(chips),
+                &(this->current_signal_level));
+
+        for(size_t c = 0; c < block_len*16; c++)
+        {
+            uint8_t chip = (chips[c / 8] >> (c % 8)) & 0x01;
+            if(this->first_chip)
+            {
+                this->last_chip = chip;
+                this->first_chip = false;
+            }
+            if(this->buffer_len + chip_size > WAVE_BUFFER_SIZE)
+            {
+                if(this->write_buffer() == false)
+                    return false;
+            }
+            memcpy(this->buffer + this->buffer_len,
+                    this->chip_templates[(this->last_chip << 1) | chip],
+                    chip_size);
+            this->buffer_len = this->buffer_len + chip_size;
+            this->last_chip = chip;
+        }
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Write pending samples and final header, and close the WAV file.
+  * @return Close result ok (true/false).
+  */
+bool CDPWave::writer_close(void)
+{
+    uint8_t header[WAVE_HEADER_SIZE];
+    bool result = true;
+
+    if(this->file == NULL)
+        return false;
+
+    result = this->write_buffer();
+
+    // RIFF header
+    memcpy(header, "RIFF", 4);
+    PUT_LE32(header + 4, WAVE_HEADER_SIZE - 8 + this->data_size);
+    memcpy(header + 8, "WAVE", 4);
+
+    // Format chunk (mono)
+    memcpy(header + 12, "fmt ", 4);
+    PUT_LE32(header + 16, 16);
+    PUT_LE16(header + 20, this->format);
+    PUT_LE16(header + 22, 1);
+    PUT_LE32(header + 24, this->sample_rate);
+    PUT_LE32(header + 28, this->sample_rate * this->sample_size);
+    PUT_LE16(header + 32, this->sample_size);
+    PUT_LE16(header + 34, this->sample_size * 8);
+
+    // Data chunk header
+    memcpy(header + 36, "data", 4);
+    PUT_LE32(header + 40, this->data_size);
+
+    if((fseek(this->file, 0, SEEK_SET) != 0) ||
+       (fwrite(header, 1, WAVE_HEADER_SIZE, this->file) != WAVE_HEADER_SIZE))
+        result = false;
+    fclose(this->file);
+    this->file = NULL;
+
+    return result;
+}
+
+/*****************************************************************************/
+
+/* Soft Decision Decode Methods */
+
+/**
+  * @brief  Setup the soft decision decoder and reset its state.
+  * @param  samples_per_chip Nominal number of samples for each chip.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at flush (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Setup result ok (true/false).
+  */
+bool CDPWave::decoder_setup(const float samples_per_chip, uint8_t* data_out,
+        const size_t data_out_len, cdp_stream_cb callback, void* callback_arg)
+{
+    if(samples_per_chip < 1.0)
+        return false;
+
+    this->nominal_period = samples_per_chip;
+    this->chip_period = samples_per_chip;
+    this->chip_start = 0.0;
+    this->chip_sum = 0.0;
+    this->last_sample = 0.0;
+    this->num_samples = 0;
+    this->error = false;
+    this->Decoder.setup(data_out, data_out_len, callback, callback_arg);
+
+    return true;
+}
+
+/**
+  * @brief  Soft decision decode of waveform samples (mid level at 0.0). It
+  * can be called successive times with consecutive pieces of the waveform.
+  * Samples of each chip are integrated and the chip level is decided by the
+  * sign of the sum (integrate and dump), which is much more tolerant to
+  * noise than slicing each sample. Chip timing is tracked with the zero
+  * crossings of the waveform (interpolated between samples).
+  * @param  samples_in Pointer to waveform samples.
+  * @param  samples_in_len Number of samples.
+  * @return Decode result ok (true/false on output overflow).
+  */
+bool CDPWave::decode(const float* samples_in, const size_t samples_in_len)
+{
+    if(this->error)
+        return false;
+
+    for(size_t i = 0; i < samples_in_len; i++)
+    {
+        const float sample = samples_in[i];
+        const double time = (double)this->num_samples;
+
+        // Chip finished: dump its level
+        while(time >= this->chip_start + this->chip_period)
+        {
+            if(this->soft_chip() == false)
+                return false;
+        }
+
+        // Zero crossing: correct timing with nearest chip boundary
+        if((this->num_samples > 0) &&
+           ((this->last_sample < 0.0) != (sample < 0.0)) &&
+           (this->last_sample != sample))
+        {
+            double edge = (time - 1.0) +
+                    (this->last_sample / (this->last_sample - sample));
+            double boundary = this->chip_start;
+            double phase_error = 0.0;
+            if(edge - this->chip_start > this->chip_period / 2)
+                boundary = this->chip_start + this->chip_period;
+            phase_error = edge - boundary;
+            this->chip_start = this->chip_start +
+                    (phase_error * WAVE_PHASE_GAIN);
+            this->chip_period = this->chip_period +
+                    (phase_error * WAVE_FREQ_GAIN);
+            if(this->chip_period > this->nominal_period *
+                    (1.0 + WAVE_MAX_DEVIATION))
+                this->chip_period = this->nominal_period *
+                        (1.0 + WAVE_MAX_DEVIATION);
+            if(this->chip_period < this->nominal_period *
+                    (1.0 - WAVE_MAX_DEVIATION))
+                this->chip_period = this->nominal_period *
+                        (1.0 - WAVE_MAX_DEVIATION);
+        }
+
+        this->chip_sum = this->chip_sum + sample;
+        this->last_sample = sample;
+        this->num_samples = this->num_samples + 1;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  End of waveform. A last chip with more than half of its samples
+  * is decided, and decoded bytes pending in the output array are flushed
+  * to the callback.
+  * @return Flush result ok (true/false if some output overflow happened).
+  */
+bool CDPWave::decoder_flush(void)
+{
+    if((double)this->num_samples - this->chip_start > this->chip_period / 2)
+        this->soft_chip();
+    return (this->Decoder.flush() && !(this->error));
+}
+
+/**
+  * @brief  Decode a PCM WAV file (int16 or float samples; first channel is
+  * decoded on multichannel files), reading it in fixed size chunks.
+  * @param  file_path Path of the WAV file.
+  * @param  samples_per_chip Nominal number of samples for each chip.
+  * @param  data_out Pointer to output data array to store decoded data.
+  * @param  data_out_len Number of bytes that can be stored in the output
+  * data array.
+  * @param  callback Function to call with decoded data each time the output
+  * array gets full and at the end (NULL to just fill the output array).
+  * @param  callback_arg User argument for the callback.
+  * @return Decode result ok (true/false).
+  */
+bool CDPWave::decode_file(const char* file_path, const float samples_per_chip,
+        uint8_t* data_out, const size_t data_out_len, cdp_stream_cb callback,
+        void* callback_arg)
+{
+    float samples[WAVE_BUFFER_SIZE / 4];
+    uint8_t chunk_header[8];
+    uint16_t format = 0;
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    uint32_t frame_size = 0;
+    uint32_t data_left = 0;
+    bool result = true;
+    FILE* wav_file = NULL;
+
+    if(this->decoder_setup(samples_per_chip, data_out, data_out_len,
+            callback, callback_arg) == false)
+        return false;
+
+    wav_file = fopen(file_path, "rb");
+    if(wav_file == NULL)
+        return false;
+
+    // RIFF header
+    if((fread(this->file_buffer, 1, 12, wav_file) != 12) ||
+       (memcmp(this->file_buffer, "RIFF", 4) != 0) ||
+       (memcmp(this->file_buffer + 8, "WAVE", 4) != 0))
+    {
+        fclose(wav_file);
+        return false;
+    }
+
+    // Find format and data chunks
+    while(fread(chunk_header, 1, 8, wav_file) == 8)
+    {
+        uint32_t chunk_size = GET_LE32(chunk_header + 4);
+        if(memcmp(chunk_header, "fmt ", 4) == 0)
+        {
+            if((chunk_size < 16) || (chunk_size > WAVE_BUFFER_SIZE) ||
+               (fread(this->file_buffer, 1, chunk_size + (chunk_size & 1),
+                    wav_file) < chunk_size))
+                break;
+            format = GET_LE16(this->file_buffer);
+            channels = GET_LE16(this->file_buffer + 2);
+            bits = GET_LE16(this->file_buffer + 14);
+        }
+        else if(memcmp(chunk_header, "data", 4) == 0)
+        {
+            data_left = chunk_size;
+            break;
+        }
+        else if(fseek(wav_file, chunk_size + (chunk_size & 1), SEEK_CUR) != 0)
+            break;
+    }
+    if((channels == 0) || (data_left == 0) ||
+       !(((format == WAVE_FORMAT_PCM16) && (bits == 16)) ||
+         ((format == WAVE_FORMAT_FLOAT32) && (bits == 32))))
+    {
+        fclose(wav_file);
+        return false;
+    }
+    frame_size = channels * (bits / 8);
+
+    // Read, convert and decode samples
+    while(result && (data_left >= frame_size))
+    {
+        size_t read_len = frame_size * (sizeof(samples) / sizeof(float));
+        size_t num_frames = 0;
+        if(read_len > WAVE_BUFFER_SIZE)
+            read_len = WAVE_BUFFER_SIZE - (WAVE_BUFFER_SIZE % frame_size);
+        if(read_len > data_left)
+            read_len = data_left - (data_left % frame_size);
+        read_len = fread(this->file_buffer, 1, read_len, wav_file);
+        num_frames = read_len / frame_size;
+        if(num_frames == 0)
+            break;
+        data_left = data_left - (uint32_t)read_len;
+
+        for(size_t i = 0; i < num_frames; i++)
+        {
+            const uint8_t* frame = this->file_buffer + (i * frame_size);
+            if(format == WAVE_FORMAT_PCM16)
+                samples[i] = (int16_t)GET_LE16(frame) / 32768.0f;
+            else
+            {
+                uint32_t value = GET_LE32(frame);
+                memcpy(&(samples[i]), &value, sizeof(float));
+            }
+        }
+        result = this->decode(samples, num_frames);
+    }
+    fclose(wav_file);
+
+    return (this->decoder_flush() && result);
+}
+
+/*****************************************************************************/
+
+/* Getters */
+
+/* Get number of decoded bytes currently stored in the output array */
+size_t CDPWave::get_decoded_len(void)
+{   return this->Decoder.get_decoded_len();   }
+
+/* Get sample rate of the last WAV file written */
+uint32_t CDPWave::get_sample_rate(void)
+{   return this->sample_rate;   }
+
+/*****************************************************************************/
+
+/* Private Methods */
+
+/**
+  * @brief  Precompute the samples block of a chip, in the output format,
+  * for each previous and current chip levels combination: steady LOW,
+  * rising edge, falling edge and steady HIGH.
+  * @param  amplitude Chips amplitude (0.0 to 1.0 of full scale).
+  * @param  rise_samples Samples of the ramp between levels.
+  */
+void CDPWave::build_templates(const float amplitude,
+        const uint16_t rise_samples)
+{
+    for(uint8_t t = 0; t < 4; t++)
+    {
+        float from = (t & 0x02) ? amplitude : -amplitude;
+        float to = (t & 0x01) ? amplitude : -amplitude;
+
+        for(uint16_t i = 0; i < this->samples_per_chip; i++)
+        {
+            float value = to;
+            uint8_t* sample = this->chip_templates[t] + (i * this->sample_size);
+            if(i < rise_samples)
+                value = from + ((to - from) * (i + 1) / (rise_samples + 1));
+
+            if(this->format == WAVE_FORMAT_PCM16)
+                PUT_LE16(sample, (uint16_t)(int16_t)(value * 32767.0f));
+            else
+            {
+                uint32_t bits = 0;
+                memcpy(&bits, &value, sizeof(float));
+                PUT_LE32(sample, bits);
+            }
+        }
+    }
+}
+
+/**
+  * @brief  Write buffered bytes to the WAV file.
+  * @return Write result ok (true/false, also false if the data chunk would
+  * exceed the 32 bits RIFF size limit).
+  */
+bool CDPWave::write_buffer(void)
+{
+    if(this->buffer_len == 0)
+        return true;
+
+    // RIFF chunk sizes are 32 bits, refuse to write past the limit
+    if((uint64_t)this->data_size + this->buffer_len >
+            (uint64_t)UINT32_MAX - WAVE_HEADER_SIZE)
+        return false;
+    if(fwrite(this->buffer, 1, this->buffer_len, this->file) !=
+            this->buffer_len)
+        return false;
+    this->data_size = this->data_size + (uint32_t)this->buffer_len;
+    this->buffer_len = 0;
+
+    return true;
+}
+
+/**
+  * @brief  Decide current chip level from the sign of its samples sum and
+  * push it to the decoder.
+  * @return Result ok (true/false on output overflow).
+  */
+bool CDPWave::soft_chip(void)
+{
+    uint8_t chip = (this->chip_sum > 0.0) ? LOGIC_LEVEL_HIGH : LOGIC_LEVEL_LOW;
+
+    this->chip_sum = 0.0;
+    this->chip_start = this->chip_start + this->chip_period;
+    if(this->Decoder.push_chip(chip) == false)
+    {
+        this->error = true;
+        return false;
+    }
+    return true;
+}
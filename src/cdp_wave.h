@@ -0,0 +1,131 @@
+/**
+ * @file    cdp_wave.h
+ * @author  Jose Miguel Rios Rubio <jrios.github@gmail.com>
+ * @date    16-10-2026
+ * @version 1.0.0
+ *
+ * @section DESCRIPTION
+ *
+ * Conditional DePhase (Differential Manchester) waveform synthesis to
+ * PCM WAV files (int16 or float samples, with optional rise time shaping)
+ * and soft decision decode of PCM WAV files.
+ *
+ * @section LICENSE
+ *
+ * Copyright (c) 2020 Jose Miguel Rios Rubio. All right reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*****************************************************************************/
+
+/* Include Guard */
+
+#ifndef CDP_WAVE_H_
+#define CDP_WAVE_H_
+
+/*****************************************************************************/
+
+/* Libraries */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "cdp.h"
+#include "cdp_stream.h"
+
+/*****************************************************************************/
+
+/* Constants */
+
+// WAV samples formats
+#define WAVE_FORMAT_PCM16   1
+#define WAVE_FORMAT_FLOAT32 3
+
+// Maximum number of samples for each chip on synthesis
+#define WAVE_MAX_SAMPLES_PER_CHIP 256
+
+// Bytes of the file buffer
+#define WAVE_BUFFER_SIZE 16384
+
+/*****************************************************************************/
+
+/* Class Interface */
+
+class CDPWave
+{
+    public:
+
+        CDPWave();
+        ~CDPWave();
+
+        bool writer_open(const char* file_path, const uint32_t sample_rate,
+                const uint16_t format, const uint16_t samples_per_chip,
+                const float amplitude, const uint16_t rise_samples);
+        bool write(const uint8_t* data_in, const size_t data_in_len);
+        bool writer_close(void);
+
+        bool decoder_setup(const float samples_per_chip, uint8_t* data_out,
+                const size_t data_out_len, cdp_stream_cb callback,
+                void* callback_arg);
+        bool decode(const float* samples_in, const size_t samples_in_len);
+        bool decoder_flush(void);
+        bool decode_file(const char* file_path, const float samples_per_chip,
+                uint8_t* data_out, const size_t data_out_len,
+                cdp_stream_cb callback, void* callback_arg);
+
+        size_t get_decoded_len(void);
+        uint32_t get_sample_rate(void);
+
+    private:
+
+        CDP Cdp;
+        CDPStreamDecoder Decoder;
+        uint8_t buffer[WAVE_BUFFER_SIZE];
+        size_t buffer_len;
+
+        // Writer state
+        FILE* file;
+        uint32_t sample_rate;
+        uint16_t format;
+        uint16_t sample_size;
+        uint16_t samples_per_chip;
+        uint8_t chip_templates[4][WAVE_MAX_SAMPLES_PER_CHIP * 4];
+        uint8_t current_signal_level;
+        uint8_t last_chip;
+        bool first_chip;
+        uint32_t data_size;
+
+        // Soft decision decoder state
+        uint8_t file_buffer[WAVE_BUFFER_SIZE];
+        double nominal_period;
+        double chip_period;
+        double chip_start;
+        double chip_sum;
+        float last_sample;
+        uint64_t num_samples;
+        bool error;
+
+        void build_templates(const float amplitude,
+                const uint16_t rise_samples);
+        bool write_buffer(void);
+        bool soft_chip(void);
+};
+
+/*****************************************************************************/
+
+#endif /* CDP_WAVE_H_ */
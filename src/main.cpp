@@ -38,8 +38,27 @@
 #include <inttypes.h>
 #include <string.h>
 #include <time.h> 
+#include <math.h>
 
 #include "cdp.h"
+#include "cdp_oversampled.h"
+#include "cdp_edges.h"
+#include "cdp_capture.h"
+#include "cdp_wave.h"
+#include "cdp_delimiter.h"
+#include "cdp_frame.h"
+#include "cdp_ring.h"
+#include "cdp_parallel.h"
+#include "cdp_cache.h"
+#include "cdp_template.h"
+#include "cdp_rope.h"
+#include "cdp_search.h"
+#include "cdp_transcode.h"
+#include "cdp_linecode.h"
+#include "cdp_aes3.h"
+#include "cdp_usbpd.h"
+#include "cdp_scrambler.h"
+#include "cdp_multichannel.h"
 
 /*****************************************************************************/
 
@@ -60,8 +79,49 @@ static inline void printfb(const uint8_t b)
 /* Functions Prototypes */
 
 uint8_t gen_random_byte(void);
+size_t oversample_chips(const uint8_t* chips, const size_t num_chips,
+        const double samples_per_chip, const double drift,
+        uint8_t* samples, const size_t samples_len);
+size_t chips_to_edges(const uint8_t* chips, const size_t num_chips,
+        const uint8_t idle_level, const uint64_t start_time,
+        const uint32_t ticks_per_chip, const uint32_t jitter,
+        uint64_t* edges, const size_t edges_len);
+uint64_t append_chips(uint8_t* chips, uint64_t num_chips,
+        const uint8_t* chips_in, const uint64_t chips_in_len);
+void collect_data(const uint8_t* data, const size_t data_len, void* arg);
+void line_code_encode_ref(const uint8_t code, const uint8_t convention,
+        const uint8_t bit_order, uint8_t level, const uint8_t* data,
+        const size_t data_len, uint8_t* chips);
+template <uint8_t CODE, uint8_t CONVENTION, uint8_t BIT_ORDER,
+        uint8_t INITIAL_LEVEL>
+bool check_line_code(const uint8_t* data, const size_t data_len);
 bool test0(void);
 bool test1(void);
+bool test2(void);
+bool test3(void);
+bool test4(void);
+bool test5(void);
+bool test6(void);
+bool test7(void);
+bool test8(void);
+bool test9(void);
+bool test10(void);
+bool test11(void);
+bool test12(void);
+bool test13(void);
+bool test14(void);
+bool test15(void);
+bool test16(void);
+bool test17(void);
+bool test18(void);
+bool test19(void);
+bool test20(void);
+bool test21(void);
+bool test22(void);
+bool test23(void);
+bool test24(void);
+bool test25(void);
+bool test26(void);
 
 /*****************************************************************************/
 
@@ -75,12 +135,2408 @@ int main(int argc, char *argv[])
 {
     test0() ? printf("TEST 0 Result - OK") : printf("TEST 0 Result - FAIL");
     test1() ? printf("TEST 1 Result - OK") : printf("TEST 1 Result - FAIL");
+    test2() ? printf("TEST 2 Result - OK") : printf("TEST 2 Result - FAIL");
+    test3() ? printf("TEST 3 Result - OK") : printf("TEST 3 Result - FAIL");
+    test4() ? printf("TEST 4 Result - OK") : printf("TEST 4 Result - FAIL");
+    test5() ? printf("TEST 5 Result - OK") : printf("TEST 5 Result - FAIL");
+    test6() ? printf("TEST 6 Result - OK") : printf("TEST 6 Result - FAIL");
+    test7() ? printf("TEST 7 Result - OK") : printf("TEST 7 Result - FAIL");
+    test8() ? printf("TEST 8 Result - OK") : printf("TEST 8 Result - FAIL");
+    test9() ? printf("TEST 9 Result - OK") : printf("TEST 9 Result - FAIL");
+    test10() ? printf("TEST 10 Result - OK") :
+            printf("TEST 10 Result - FAIL");
+    test11() ? printf("TEST 11 Result - OK") :
+            printf("TEST 11 Result - FAIL");
+    test12() ? printf("TEST 12 Result - OK") :
+            printf("TEST 12 Result - FAIL");
+    test13() ? printf("TEST 13 Result - OK") :
+            printf("TEST 13 Result - FAIL");
+    test14() ? printf("TEST 14 Result - OK") :
+            printf("TEST 14 Result - FAIL");
+    test15() ? printf("TEST 15 Result - OK") :
+            printf("TEST 15 Result - FAIL");
+    test16() ? printf("TEST 16 Result - OK") :
+            printf("TEST 16 Result - FAIL");
+    test17() ? printf("TEST 17 Result - OK") :
+            printf("TEST 17 Result - FAIL");
+    test18() ? printf("TEST 18 Result - OK") :
+            printf("TEST 18 Result - FAIL");
+    test19() ? printf("TEST 19 Result - OK") :
+            printf("TEST 19 Result - FAIL");
+    test20() ? printf("TEST 20 Result - OK") :
+            printf("TEST 20 Result - FAIL");
+    test21() ? printf("TEST 21 Result - OK") :
+            printf("TEST 21 Result - FAIL");
+    test22() ? printf("TEST 22 Result - OK") :
+            printf("TEST 22 Result - FAIL");
+    test23() ? printf("TEST 23 Result - OK") :
+            printf("TEST 23 Result - FAIL");
+    test24() ? printf("TEST 24 Result - OK") :
+            printf("TEST 24 Result - FAIL");
+    test25() ? printf("TEST 25 Result - OK") :
+            printf("TEST 25 Result - FAIL");
+    test26() ? printf("TEST 26 Result - OK") :
+            printf("TEST 26 Result - FAIL");
 
     printf("\n\n--------------------------------\n\n");
 
     return 0;
 }
 
+/**
+  * @brief  Test multi-channel encoder: random data of 8 and 16 channels is
+  * encoded into transposed chip words in two pieces, and each chip word
+  * bit must be the chip of its channel from encode() of the channel data.
+  * End signal levels must be the same too.
+  * @return Test result.
+  */
+bool test26(void)
+{
+    const size_t DATA_SIZE = 1027;
+    static uint8_t data[16][DATA_SIZE];
+    static uint8_t encoded_ref[16][DATA_SIZE*2];
+    static uint8_t encoded_data[DATA_SIZE*16*2];
+    const uint8_t* channels_data[16];
+    const uint8_t* channels_next[16];
+    CDPMultiChannel MultiChannel;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 26:\n\n");
+
+    for(uint8_t c = 0; c < 16; c++)
+    {
+        for(size_t i = 0; i < DATA_SIZE; i++)
+            data[c][i] = gen_random_byte();
+        channels_data[c] = data[c];
+    }
+
+    for(uint8_t num_channels = 8; num_channels <= 16; num_channels += 8)
+    {
+        const size_t FIRST_SIZE = 1 + (size_t)rand() % (DATA_SIZE - 1);
+        const uint8_t word_len = num_channels / 8;
+        uint16_t levels = 0;
+
+        // Reference: encode() of each channel
+        for(uint8_t c = 0; c < num_channels; c++)
+        {
+            uint8_t level = INITIAL_SIGNAL_LEVEL;
+            Cdp.encode(data[c], DATA_SIZE, encoded_ref[c],
+                    sizeof(encoded_ref[c]), &level);
+            levels = levels | (level << c);
+            channels_next[c] = data[c] + FIRST_SIZE;
+        }
+
+        if((MultiChannel.setup(num_channels) == false) ||
+           (MultiChannel.encode(channels_data, FIRST_SIZE, encoded_data,
+                sizeof(encoded_data)) == false) ||
+           (MultiChannel.encode(channels_next, DATA_SIZE - FIRST_SIZE,
+                encoded_data + FIRST_SIZE*16*word_len,
+                sizeof(encoded_data) - FIRST_SIZE*16*word_len) == false))
+        {
+            printf("%d channels - FAIL! Encode error.\n", num_channels);
+            return false;
+        }
+        for(size_t k = 0; k < DATA_SIZE*16; k++)
+        {
+            uint16_t word = encoded_data[k*word_len];
+            if(word_len == 2)
+                word = word | (encoded_data[k*2 + 1] << 8);
+            for(uint8_t c = 0; c < num_channels; c++)
+            {
+                if(((word >> c) & 0x01) !=
+                   ((encoded_ref[c][k / 8] >> (k % 8)) & 0x01))
+                {
+                    printf("%d channels - FAIL! Chip %d of channel %d != "
+                            "encode().\n", num_channels, (int)k, c);
+                    return false;
+                }
+            }
+        }
+        if(MultiChannel.get_levels() != levels)
+        {
+            printf("%d channels - FAIL! End levels != encode().\n",
+                    num_channels);
+            return false;
+        }
+    }
+    printf("Ok, transposed chip words == encode() of each channel.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test batch encode: many tiny frames (3 to 64 bytes) with random
+  * start signal levels are encoded in one batch, and each one must be the
+  * same as its own encode() output, with the right end level. Time of the
+  * batch encode and of an encode() call for each frame is shown.
+  * @return Test result.
+  */
+bool test25(void)
+{
+    const size_t NUM_FRAMES = 20000;
+    const size_t MAX_FRAME_SIZE = 64;
+    static uint8_t data[NUM_FRAMES][MAX_FRAME_SIZE];
+    static uint8_t encoded_ref[NUM_FRAMES][MAX_FRAME_SIZE*2];
+    static uint8_t encoded_data[NUM_FRAMES][MAX_FRAME_SIZE*2];
+    static cdp_batch_frame_t frames[NUM_FRAMES];
+    static uint8_t levels[NUM_FRAMES];
+    clock_t start;
+    double ref_time = 0.0;
+    double batch_time = 0.0;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 25:\n\n");
+
+    for(size_t n = 0; n < NUM_FRAMES; n++)
+    {
+        frames[n].data_in = data[n];
+        frames[n].data_in_len = 3 + (size_t)rand() % (MAX_FRAME_SIZE - 2);
+        frames[n].data_out = encoded_data[n];
+        frames[n].data_out_len = sizeof(encoded_data[n]);
+        frames[n].level = gen_random_byte() & 0x01;
+        levels[n] = frames[n].level;
+        for(size_t i = 0; i < frames[n].data_in_len; i++)
+            data[n][i] = gen_random_byte();
+    }
+
+    // Batch encode
+    start = clock();
+    if(Cdp.encode_batch(frames, NUM_FRAMES) == false)
+    {
+        printf("FAIL! Batch encode error.\n");
+        return false;
+    }
+    batch_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Reference: encode() for each frame
+    start = clock();
+    for(size_t n = 0; n < NUM_FRAMES; n++)
+    {
+        Cdp.encode(data[n], frames[n].data_in_len, encoded_ref[n],
+                sizeof(encoded_ref[n]), &(levels[n]));
+    }
+    ref_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    for(size_t n = 0; n < NUM_FRAMES; n++)
+    {
+        if((memcmp(encoded_data[n], encoded_ref[n],
+                frames[n].data_in_len*2) != 0) ||
+           (frames[n].level != levels[n]))
+        {
+            printf("Frame %d - FAIL! Batch encoded frame != encode().\n",
+                    (int)n);
+            return false;
+        }
+    }
+    printf("Encode time: %.3f ms (batch), %.3f ms (frame by frame).\n",
+            batch_time*1000.0, ref_time*1000.0);
+    printf("Ok, batch encoded frames == encoded frames.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test typed integer arrays encode: random uint16, uint32 and
+  * uint64 arrays (odd number of values) are encoded in network byte order,
+  * with LSb and MSb first bits, and must be the same as the encode of the
+  * values swapped to a bytes buffer. Decoded arrays must be the same.
+  * @return Test result.
+  */
+bool test24(void)
+{
+    const size_t NUM_VALUES = 1001;
+    static uint16_t values16[NUM_VALUES];
+    static uint32_t values32[NUM_VALUES];
+    static uint64_t values64[NUM_VALUES];
+    static uint16_t decoded16[NUM_VALUES];
+    static uint32_t decoded32[NUM_VALUES];
+    static uint64_t decoded64[NUM_VALUES];
+    static uint8_t wire_data[NUM_VALUES*8];
+    static uint8_t encoded_ref[NUM_VALUES*8*2];
+    static uint8_t encoded_data[NUM_VALUES*8*2];
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 24:\n\n");
+
+    for(size_t i = 0; i < NUM_VALUES; i++)
+    {
+        values64[i] = 0;
+        for(uint8_t k = 0; k < 8; k++)
+            values64[i] = (values64[i] << 8) | gen_random_byte();
+        values32[i] = (uint32_t)(values64[i] >> 16);
+        values16[i] = (uint16_t)(values64[i] >> 40);
+    }
+
+    for(uint8_t size = 2; size <= 8; size = size * 2)
+    {
+        for(uint8_t msb_first = 0; msb_first < 2; msb_first++)
+        {
+            const size_t num_bytes = NUM_VALUES*size;
+            uint8_t level = INITIAL_SIGNAL_LEVEL;
+            bool ok = true;
+
+            // Reference: values swapped to a bytes buffer
+            for(size_t i = 0; i < NUM_VALUES; i++)
+            {
+                for(uint8_t k = 0; k < size; k++)
+                {
+                    uint64_t value = (size == 2) ? values16[i] :
+                            ((size == 4) ? values32[i] : values64[i]);
+                    uint8_t b = (uint8_t)(value >> (8*(size - 1 - k)));
+                    wire_data[i*size + k] = msb_first ? reverse_bits8(b) : b;
+                }
+            }
+            Cdp.encode(wire_data, num_bytes, encoded_ref, sizeof(encoded_ref),
+                    &level);
+
+            // Typed encode and decode
+            level = INITIAL_SIGNAL_LEVEL;
+            if(size == 2)
+                ok = Cdp.encode_be(values16, NUM_VALUES, encoded_data,
+                        sizeof(encoded_data), &level, msb_first);
+            else if(size == 4)
+                ok = Cdp.encode_be(values32, NUM_VALUES, encoded_data,
+                        sizeof(encoded_data), &level, msb_first);
+            else
+                ok = Cdp.encode_be(values64, NUM_VALUES, encoded_data,
+                        sizeof(encoded_data), &level, msb_first);
+            if((ok == false) ||
+               (memcmp(encoded_data, encoded_ref, num_bytes*2) != 0))
+            {
+                printf("uint%d (MSb first %d) - FAIL! Encoded data != "
+                        "reference.\n", size*8, msb_first);
+                return false;
+            }
+            level = INITIAL_SIGNAL_LEVEL;
+            if(size == 2)
+                ok = Cdp.decode_be(encoded_data, num_bytes*2, decoded16,
+                        NUM_VALUES, &level, msb_first) &&
+                     (memcmp(decoded16, values16, sizeof(values16)) == 0);
+            else if(size == 4)
+                ok = Cdp.decode_be(encoded_data, num_bytes*2, decoded32,
+                        NUM_VALUES, &level, msb_first) &&
+                     (memcmp(decoded32, values32, sizeof(values32)) == 0);
+            else
+                ok = Cdp.decode_be(encoded_data, num_bytes*2, decoded64,
+                        NUM_VALUES, &level, msb_first) &&
+                     (memcmp(decoded64, values64, sizeof(values64)) == 0);
+            if(ok == false)
+            {
+                printf("uint%d (MSb first %d) - FAIL! Decoded values != "
+                        "values.\n", size*8, msb_first);
+                return false;
+            }
+        }
+    }
+    printf("Ok, typed encode == encode of swapped values, and decoded "
+            "values == values.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test CRC fused into decode: random frames followed by their FCS
+  * (CRC-32, CRC-16/X-25 and CRC-16/CCITT-FALSE) are encoded, and decoded
+  * updating the CRC in the same pass, by CDP::decode() and by the stream
+  * decoder (chips pushed in random pieces). The CRC must be the same as
+  * the CRC of the data computed afterwards, the FCS must check ok, and it
+  * must fail on a frame with a corrupted bit.
+  * @return Test result.
+  */
+bool test23(void)
+{
+    const size_t MAX_DATA_SIZE = 1500;
+    const uint8_t WIDTHS[3] = { 32, 16, 16 };
+    const uint32_t POLYNOMIALS[3] = { 0x04C11DB7, 0x1021, 0x1021 };
+    const uint32_t INITS[3] = { 0xFFFFFFFF, 0xFFFF, 0xFFFF };
+    const bool REFLECTED[3] = { true, true, false };
+    const uint32_t XOR_OUTS[3] = { 0xFFFFFFFF, 0xFFFF, 0x0000 };
+    static uint8_t data[MAX_DATA_SIZE + 4];
+    static uint8_t encoded_data[(MAX_DATA_SIZE + 4)*2];
+    static uint8_t decoded_data[MAX_DATA_SIZE + 4];
+    CDPStreamDecoder Decoder;
+    CDPCrc Crc;
+    CDPCrc DecodeCrc;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 23:\n\n");
+
+    Decoder.setup(decoded_data, sizeof(decoded_data), NULL, NULL);
+    Decoder.set_crc(&DecodeCrc);
+    for(uint16_t n = 0; n < 300; n++)
+    {
+        const uint8_t type = n % 3;
+        const uint8_t fcs_len = WIDTHS[type] / 8;
+        const size_t data_len = 1 + (size_t)rand() % MAX_DATA_SIZE;
+        const bool corrupted = (n % 10 == 9);
+        uint8_t level = INITIAL_SIGNAL_LEVEL;
+        uint32_t crc = 0;
+        size_t chip_n = 0;
+
+        // Frame with its FCS (little-endian if reflected)
+        for(size_t i = 0; i < data_len; i++)
+            data[i] = gen_random_byte();
+        Crc.setup(WIDTHS[type], POLYNOMIALS[type], INITS[type],
+                REFLECTED[type], XOR_OUTS[type]);
+        Crc.update(data, data_len);
+        crc = Crc.get_crc();
+        if((type == 0) &&
+           (crc != crc32_final(crc32_update(CRC32_INIT, data, data_len))))
+        {
+            printf("Frame %d - FAIL! CRC-32 != crc32_update().\n", n);
+            return false;
+        }
+        for(uint8_t i = 0; i < fcs_len; i++)
+        {
+            if(REFLECTED[type])
+                data[data_len + i] = (uint8_t)(crc >> (8*i));
+            else
+                data[data_len + i] = (uint8_t)(crc >> (8*(fcs_len - 1 - i)));
+        }
+        Cdp.encode(data, data_len + fcs_len, encoded_data,
+                sizeof(encoded_data), &level);
+        if(corrupted)
+            encoded_data[rand() % (data_len*2)] ^= 0x03;
+
+        // Decode with CRC update
+        level = INITIAL_SIGNAL_LEVEL;
+        DecodeCrc.setup(WIDTHS[type], POLYNOMIALS[type], INITS[type],
+                REFLECTED[type], XOR_OUTS[type]);
+        if((Cdp.decode(encoded_data, data_len*2, decoded_data,
+                sizeof(decoded_data), &level, &DecodeCrc) == false) ||
+           (DecodeCrc.get_crc() != crc) != corrupted)
+        {
+            printf("Frame %d - FAIL! Decode CRC != data CRC.\n", n);
+            return false;
+        }
+        DecodeCrc.reset();
+        level = INITIAL_SIGNAL_LEVEL;
+        Cdp.decode(encoded_data, (data_len + fcs_len)*2, decoded_data,
+                sizeof(decoded_data), &level, &DecodeCrc);
+        if(DecodeCrc.get_fcs_ok() == corrupted)
+        {
+            printf("Frame %d - FAIL! Decode FCS check.\n", n);
+            return false;
+        }
+
+        // Stream decode with CRC update
+        Decoder.reset();
+        while(chip_n < (data_len + fcs_len)*16)
+        {
+            size_t num_chips = 1 + (size_t)rand() % 300;
+            if(chip_n + num_chips > (data_len + fcs_len)*16)
+                num_chips = (data_len + fcs_len)*16 - chip_n;
+            if((chip_n % 8 == 0) && (num_chips % 8 == 0))
+                Decoder.push_chips(encoded_data + chip_n/8, num_chips);
+            else
+            {
+                for(size_t i = chip_n; i < chip_n + num_chips; i++)
+                    Decoder.push_chip((encoded_data[i/8] >> (i%8)) & 0x01);
+            }
+            chip_n = chip_n + num_chips;
+        }
+        Decoder.resync(level);
+        if((Decoder.get_decoded_len() != data_len + fcs_len) ||
+           (DecodeCrc.get_fcs_ok() == corrupted))
+        {
+            printf("Frame %d - FAIL! Stream decode FCS check.\n", n);
+            return false;
+        }
+    }
+    printf("Ok, CRCs updated on decode == CRCs of the data, and FCS checks "
+            "ok (failed on corrupted frames).\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test LFSR scrambler: random data is scrambled and encoded in two
+  * pieces by the fused scrambler encoder, and it must be the same as the
+  * CDP encode of the data scrambled bit by bit, for additive and
+  * self-synchronizing polynomials. The fused decoder must get the data back,
+  * and scramble() and descramble() must match the bit by bit results too.
+  * @return Test result.
+  */
+bool test22(void)
+{
+    const size_t DATA_SIZE = 4099;
+    const uint8_t TYPES[3] = { SCRAMBLER_ADDITIVE, SCRAMBLER_ADDITIVE,
+            SCRAMBLER_SELF_SYNC };
+    const uint64_t POLYNOMIALS[3] = { (1ULL << 7) | (1ULL << 4),
+            (1ULL << 15) | (1ULL << 14), (1ULL << 58) | (1ULL << 39) };
+    static uint8_t data[DATA_SIZE];
+    static uint8_t scrambled_ref[DATA_SIZE];
+    static uint8_t scrambled[DATA_SIZE];
+    static uint8_t decoded_data[DATA_SIZE];
+    static uint8_t encoded_ref[DATA_SIZE*2];
+    static uint8_t encoded_data[DATA_SIZE*2];
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 22:\n\n");
+
+    for(size_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+
+    for(uint8_t n = 0; n < 3; n++)
+    {
+        const size_t FIRST_SIZE = 1 + (size_t)rand() % (DATA_SIZE - 1);
+        const uint64_t mask = POLYNOMIALS[n] >> 1;
+        uint64_t seed = 0;
+        uint64_t state = 0;
+        uint8_t level = LOGIC_LEVEL_HIGH;
+        CDPScrambler Scrambler;
+
+        for(uint8_t i = 0; i < 8; i++)
+            seed = (seed << 8) | gen_random_byte();
+        if(seed == 0)
+            seed = 1;
+
+        // Scramble bit by bit
+        state = seed;
+        for(size_t i = 0; i < DATA_SIZE*8; i++)
+        {
+            uint64_t x = (data[i / 8] >> (i % 8)) & 0x01;
+            uint64_t k = 0;
+            for(uint64_t taps = state & mask; taps != 0; taps &= taps - 1)
+                k = k ^ 1;
+            x = x ^ k;
+            state = (state << 1) | ((TYPES[n] == SCRAMBLER_ADDITIVE) ? k : x);
+            if(i % 8 == 0)
+                scrambled_ref[i / 8] = 0;
+            scrambled_ref[i / 8] |= (uint8_t)(x << (i % 8));
+        }
+        Cdp.encode(scrambled_ref, DATA_SIZE, encoded_ref,
+                sizeof(encoded_ref));
+
+        // Fused scramble and encode
+        if((Scrambler.setup(TYPES[n], POLYNOMIALS[n], seed) == false) ||
+           (Scrambler.encode(data, FIRST_SIZE, encoded_data,
+                sizeof(encoded_data), &level) == false) ||
+           (Scrambler.encode(data + FIRST_SIZE, DATA_SIZE - FIRST_SIZE,
+                encoded_data + FIRST_SIZE*2,
+                sizeof(encoded_data) - FIRST_SIZE*2, &level) == false))
+        {
+            printf("Polynomial %d - FAIL! Scrambler encode error.\n", n);
+            return false;
+        }
+        if(memcmp(encoded_data, encoded_ref, sizeof(encoded_ref)) != 0)
+        {
+            printf("Polynomial %d - FAIL! Encoded data != reference.\n", n);
+            return false;
+        }
+
+        // Fused decode and descramble
+        level = LOGIC_LEVEL_HIGH;
+        if((Scrambler.setup(TYPES[n], POLYNOMIALS[n], seed) == false) ||
+           (Scrambler.decode(encoded_data, FIRST_SIZE*2, decoded_data,
+                sizeof(decoded_data), &level) == false) ||
+           (Scrambler.decode(encoded_data + FIRST_SIZE*2,
+                (DATA_SIZE - FIRST_SIZE)*2, decoded_data + FIRST_SIZE,
+                sizeof(decoded_data) - FIRST_SIZE, &level) == false))
+        {
+            printf("Polynomial %d - FAIL! Scrambler decode error.\n", n);
+            return false;
+        }
+        if(memcmp(decoded_data, data, DATA_SIZE) != 0)
+        {
+            printf("Polynomial %d - FAIL! Decoded data != data.\n", n);
+            return false;
+        }
+
+        // Scramble and descramble without encoding
+        Scrambler.setup(TYPES[n], POLYNOMIALS[n], seed);
+        Scrambler.scramble(data, DATA_SIZE, scrambled, sizeof(scrambled));
+        Scrambler.setup(TYPES[n], POLYNOMIALS[n], seed);
+        Scrambler.descramble(scrambled, DATA_SIZE, decoded_data,
+                sizeof(decoded_data));
+        if((memcmp(scrambled, scrambled_ref, DATA_SIZE) != 0) ||
+           (memcmp(decoded_data, data, DATA_SIZE) != 0))
+        {
+            printf("Polynomial %d - FAIL! Scramble != reference.\n", n);
+            return false;
+        }
+    }
+    printf("Ok, fused scramble & encode == scramble + encode, and decoded "
+            "data == data.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test USB Power Delivery codec: packets with random ordered sets
+  * and messages are encoded and placed in a stream with random idle gaps,
+  * and the packets decoded from the stream must be the same, with one
+  * corrupted packet reported as an error without losing the next ones.
+  * @return Test result.
+  */
+bool test21(void)
+{
+    const uint16_t NUM_PACKETS = 200;
+    const uint16_t BAD_PACKET = 77;
+    const uint16_t MAX_PACKET_CHIPS = 2*64 + 40 + (30 + 4)*20 + 10;
+    static uint8_t stream[NUM_PACKETS*(MAX_PACKET_CHIPS + 64)/8 + 8];
+    static uint8_t messages[NUM_PACKETS][30];
+    static uint16_t messages_len[NUM_PACKETS];
+    static uint8_t ordered_sets[NUM_PACKETS];
+    static uint64_t start_chips[NUM_PACKETS];
+    uint8_t encoded_data[(MAX_PACKET_CHIPS + 7)/8];
+    uint8_t idle[8];
+    cdp_usbpd_packet_t packet;
+    uint64_t num_chips = 0;
+    uint64_t chip_n = 0;
+    CDPUSBPD Pd;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 21:\n\n");
+
+    // Encode packets with idle gaps (line kept at the last level)
+    memset(stream, 0, sizeof(stream));
+    memset(idle, 0, sizeof(idle));
+    num_chips = (uint64_t)rand() % 64;
+    for(uint16_t n = 0; n < NUM_PACKETS; n++)
+    {
+        uint64_t packet_chips = 0;
+        uint8_t last_chip = 0;
+
+        ordered_sets[n] = gen_random_byte() % PD_NUM_ORDERED_SETS;
+        if(n == BAD_PACKET)
+            ordered_sets[n] = PD_SOP;
+        messages_len[n] = 0;
+        if(ordered_sets[n] < PD_HARD_RESET)
+            messages_len[n] = 2 + (gen_random_byte() % 8)*4;
+        for(uint16_t i = 0; i < messages_len[n]; i++)
+            messages[n][i] = gen_random_byte();
+        if(Pd.encode(ordered_sets[n], messages[n], messages_len[n],
+                encoded_data, sizeof(encoded_data), &packet_chips) == false)
+        {
+            printf("Packet %d - FAIL! Encode error.\n", n);
+            return false;
+        }
+        start_chips[n] = num_chips + 64*2;
+        if(n == BAD_PACKET)
+            encoded_data[(64*2 + 40 + 30) / 8] ^= 0x10;
+        num_chips = append_chips(stream, num_chips, encoded_data,
+                packet_chips);
+        last_chip = (encoded_data[(packet_chips - 1) / 8] >>
+                ((packet_chips - 1) % 8)) & 0x01;
+        memset(idle, last_chip ? 0xFF : 0x00, sizeof(idle));
+        num_chips = append_chips(stream, num_chips, idle,
+                (uint64_t)rand() % 64);
+    }
+
+    // Decode them
+    for(uint16_t n = 0; n < NUM_PACKETS; n++)
+    {
+        bool ok = true;
+
+        if(Pd.decode(stream, num_chips, chip_n, &packet) == false)
+        {
+            printf("Packet %d - FAIL! Packet not found.\n", n);
+            return false;
+        }
+        chip_n = packet.end_chip;
+        if(n == BAD_PACKET)
+            ok = (packet.result != PD_RESULT_OK);
+        else
+        {
+            ok = (packet.result == PD_RESULT_OK) &&
+                 (packet.message_len == messages_len[n]) &&
+                 (memcmp(packet.message, messages[n], messages_len[n]) == 0);
+        }
+        if((ok == false) || (packet.start_chip != start_chips[n]) ||
+           (packet.ordered_set != ordered_sets[n]))
+        {
+            printf("Packet %d - FAIL! Decoded packet != encoded packet.\n",
+                    n);
+            return false;
+        }
+    }
+    if(Pd.decode(stream, num_chips, chip_n, &packet))
+    {
+        printf("FAIL! Packet found past the last one.\n");
+        return false;
+    }
+    printf("Ok, decoded packets == encoded packets (corrupted packet "
+            "detected).\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test AES3 engine: a quarter second of 192 kHz stereo random
+  * samples is encoded in two pieces, placed at a random chip position of a
+  * stream, and decoded back. Samples, preambles (Z at blocks start),
+  * channel status and user data bits and parity must be right. Encode and
+  * decode time is shown as a fraction of the audio duration.
+  * @return Test result.
+  */
+bool test20(void)
+{
+    const uint32_t SAMPLE_RATE = 192000;
+    const uint32_t NUM_FRAMES = SAMPLE_RATE / 4;
+    const uint32_t NUM_SUBFRAMES = NUM_FRAMES*AES3_FRAME_SUBFRAMES;
+    static int32_t samples[NUM_SUBFRAMES];
+    static uint8_t encoded_data[NUM_SUBFRAMES*AES3_SUBFRAME_LEN];
+    static uint8_t stream[NUM_SUBFRAMES*AES3_SUBFRAME_LEN + 16];
+    static cdp_aes3_subframe_t subframes[NUM_SUBFRAMES];
+    uint8_t channel_status[AES3_CHANNEL_STATUS_LEN];
+    uint8_t user_data[AES3_USER_DATA_LEN];
+    const uint32_t split = (uint32_t)rand() % NUM_FRAMES;
+    const uint64_t start_chip = (uint64_t)rand() % 64;
+    uint64_t num_chips = 0;
+    size_t num_subframes = 0;
+    CDPAES3 Aes3;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 20:\n\n");
+
+    for(uint8_t i = 0; i < AES3_CHANNEL_STATUS_LEN; i++)
+        channel_status[i] = gen_random_byte();
+    for(uint8_t i = 0; i < AES3_USER_DATA_LEN; i++)
+        user_data[i] = gen_random_byte();
+    for(uint32_t i = 0; i < NUM_SUBFRAMES; i++)
+    {
+        samples[i] = (int32_t)((gen_random_byte() << 16) |
+                (gen_random_byte() << 8) | gen_random_byte()) - 0x800000;
+    }
+
+    // Encode
+    clock_t start = clock();
+    Aes3.encoder_setup(channel_status, user_data, true);
+    Aes3.encode(samples, split, encoded_data, sizeof(encoded_data));
+    Aes3.encode(samples + split*AES3_FRAME_SUBFRAMES, NUM_FRAMES - split,
+            encoded_data + split*AES3_FRAME_SUBFRAMES*AES3_SUBFRAME_LEN,
+            sizeof(encoded_data) -
+            split*AES3_FRAME_SUBFRAMES*AES3_SUBFRAME_LEN);
+    double encode_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Decode from a random chip position of a stream
+    memset(stream, 0, sizeof(stream));
+    num_chips = append_chips(stream, start_chip, encoded_data,
+            sizeof(encoded_data)*8);
+    start = clock();
+    num_subframes = Aes3.decode(stream, num_chips, 0, subframes,
+            NUM_SUBFRAMES);
+    double decode_time = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if(num_subframes != NUM_SUBFRAMES)
+    {
+        printf("FAIL! %zu subframes decoded, expected %" PRIu32 ".\n",
+                num_subframes, NUM_SUBFRAMES);
+        return false;
+    }
+
+    for(uint32_t i = 0; i < NUM_SUBFRAMES; i++)
+    {
+        uint32_t frame_n = (i / 2) % AES3_BLOCK_FRAMES;
+        uint8_t preamble = (i % 2) ? AES3_PREAMBLE_Y :
+                ((frame_n == 0) ? AES3_PREAMBLE_Z : AES3_PREAMBLE_X);
+        uint8_t c_bit = (channel_status[frame_n / 8] >> (frame_n % 8)) & 0x01;
+        uint8_t u_bit = (user_data[frame_n / 8] >> (frame_n % 8)) & 0x01;
+
+        if((subframes[i].chip != start_chip + i*AES3_SUBFRAME_CHIPS) ||
+           (subframes[i].sample != samples[i]) ||
+           (subframes[i].preamble != preamble) ||
+           (((subframes[i].vucp & AES3_U_BIT) != 0) != u_bit) ||
+           (((subframes[i].vucp & AES3_C_BIT) != 0) != c_bit) ||
+           ((subframes[i].vucp & AES3_V_BIT) != 0) ||
+           (subframes[i].parity_ok == false))
+        {
+            printf("Subframe %" PRIu32 " - FAIL! Decoded subframe != "
+                    "encoded subframe.\n", i);
+            return false;
+        }
+    }
+    printf("Ok, decoded subframes == encoded subframes.\n");
+    printf("Encode %.2f%%, decode %.2f%% of 192 kHz stereo real time.\n\n",
+            encode_time*100.0*SAMPLE_RATE/NUM_FRAMES,
+            decode_time*100.0*SAMPLE_RATE/NUM_FRAMES);
+
+    return true;
+}
+
+/**
+  * @brief  Test line codes family: every code, transition convention, bit
+  * order and initial level must encode random data as the reference
+  * encoder built from the codes transitions rules, and decode it back, and
+  * the Differential Manchester line code must be the same as CDP.
+  * @return Test result.
+  */
+bool test19(void)
+{
+    const uint16_t DATA_SIZE = 4099;
+    static uint8_t data[DATA_SIZE];
+    static uint8_t encoded_data[DATA_SIZE*2];
+    static uint8_t encoded_ref[DATA_SIZE*2];
+    CDPDiffManchester DiffManchester;
+    CDP Cdp;
+    bool ok = false;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 19:\n\n");
+
+    for(uint16_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+
+    DiffManchester.encode(data, DATA_SIZE, encoded_data,
+            sizeof(encoded_data));
+    Cdp.encode(data, DATA_SIZE, encoded_ref, sizeof(encoded_ref));
+    if(memcmp(encoded_data, encoded_ref, sizeof(encoded_ref)) != 0)
+    {
+        printf("FAIL! Differential Manchester line code != CDP.\n");
+        return false;
+    }
+    printf("Ok, Differential Manchester line code == CDP.\n");
+
+    ok = check_line_code<LINE_CODE_DIFF_MANCHESTER, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_DIFF_MANCHESTER, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_DIFF_MANCHESTER, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_DIFF_MANCHESTER, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_MANCHESTER, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_MANCHESTER, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_MANCHESTER, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_MANCHESTER, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_BIPHASE, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_BIPHASE, LINE_CONVENTION_NORMAL,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_BIPHASE, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_LSB_FIRST, LOGIC_LEVEL_HIGH>(data, DATA_SIZE) &&
+        check_line_code<LINE_CODE_BIPHASE, LINE_CONVENTION_INVERTED,
+                LINE_BIT_ORDER_MSB_FIRST, LOGIC_LEVEL_LOW>(data, DATA_SIZE);
+    if(ok)
+        printf("\n");
+
+    return ok;
+}
+
+/**
+  * @brief  Test line code transcoders: random data encoded with CDP (random
+  * starting level) is transcoded to Manchester, NRZ and NRZI in two pieces
+  * and must be the same as those codes built bit by bit, and transcoding
+  * them back must give the CDP encoded data.
+  * @return Test result.
+  */
+bool test18(void)
+{
+    const uint16_t DATA_SIZE = 10001;
+    static uint8_t data[DATA_SIZE];
+    static uint8_t encoded_data[DATA_SIZE*2];
+    static uint8_t manchester_ref[DATA_SIZE*2];
+    static uint8_t nrzi_ref[DATA_SIZE];
+    static uint8_t transcoded[DATA_SIZE*2];
+    static uint8_t transcoded_back[DATA_SIZE*2];
+    uint8_t start_level = gen_random_byte() & 0x01;
+    uint8_t level = start_level;
+    const size_t split = ((size_t)rand() % DATA_SIZE);
+    CDPTranscoder Transcoder;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 18:\n\n");
+
+    // Build the references bit by bit
+    memset(manchester_ref, 0, sizeof(manchester_ref));
+    memset(nrzi_ref, 0, sizeof(nrzi_ref));
+    for(uint16_t i = 0; i < DATA_SIZE; i++)
+    {
+        data[i] = gen_random_byte();
+        for(uint8_t bit_n = 0; bit_n < 8; bit_n++)
+        {
+            uint8_t bit = (data[i] >> bit_n) & 0x01;
+            uint32_t chip_n = (i*8 + bit_n)*2;
+            manchester_ref[chip_n/8] |= (uint8_t)((!bit) << (chip_n % 8));
+            manchester_ref[chip_n/8] |= (uint8_t)(bit << ((chip_n + 1) % 8));
+            level = level ^ bit;
+            nrzi_ref[i] |= (uint8_t)(level << bit_n);
+        }
+    }
+    level = start_level;
+    Cdp.encode(data, DATA_SIZE, encoded_data, sizeof(encoded_data), &level);
+
+    // Transcode in two pieces each way (odd sizes check the words tails)
+    for(uint8_t code = 0; code < 3; code++)
+    {
+        typedef bool (CDPTranscoder::*transcode_fn)(const uint8_t*,
+                const size_t, uint8_t*, const size_t, uint8_t*);
+        const transcode_fn TO[] = { &CDPTranscoder::cdp_to_manchester,
+                &CDPTranscoder::cdp_to_nrz, &CDPTranscoder::cdp_to_nrzi };
+        const transcode_fn FROM[] = { &CDPTranscoder::manchester_to_cdp,
+                &CDPTranscoder::nrz_to_cdp, &CDPTranscoder::nrzi_to_cdp };
+        const char* NAMES[] = { "Manchester", "NRZ", "NRZI" };
+        const uint8_t* ref[] = { manchester_ref, data, nrzi_ref };
+        const size_t ref_len[] = { sizeof(manchester_ref), DATA_SIZE,
+                DATA_SIZE };
+        const size_t ref_split[] = { split*2, split, split };
+        uint8_t level_to = start_level;
+        uint8_t level_from = start_level;
+
+        (Transcoder.*TO[code])(encoded_data, split*2, transcoded,
+                sizeof(transcoded), &level_to);
+        (Transcoder.*TO[code])(encoded_data + split*2,
+                (DATA_SIZE - split)*2, transcoded + ref_split[code],
+                sizeof(transcoded) - ref_split[code], &level_to);
+        (Transcoder.*FROM[code])(transcoded, ref_split[code],
+                transcoded_back, sizeof(transcoded_back), &level_from);
+        (Transcoder.*FROM[code])(transcoded + ref_split[code],
+                ref_len[code] - ref_split[code], transcoded_back + split*2,
+                sizeof(transcoded_back) - split*2, &level_from);
+        if((memcmp(transcoded, ref[code], ref_len[code]) != 0) ||
+           (level_to != level))
+        {
+            printf("FAIL! CDP to %s != %s reference.\n", NAMES[code],
+                    NAMES[code]);
+            return false;
+        }
+        if((memcmp(transcoded_back, encoded_data, sizeof(encoded_data)) != 0)
+           || (level_from != level))
+        {
+            printf("FAIL! %s to CDP != CDP encoded data.\n", NAMES[code]);
+            return false;
+        }
+        printf("Ok, CDP <-> %s transcode.\n", NAMES[code]);
+    }
+    printf("\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test pattern search in encoded data: patterns of different
+  * lengths are placed at random positions of random data, and the matches
+  * found in the encoded data (random starting level) must be the same as
+  * the ones found comparing the data at each position.
+  * @return Test result.
+  */
+bool test17(void)
+{
+    const uint32_t DATA_SIZE = 200000;
+    const uint16_t NUM_PLACED = 100;
+    const uint16_t MAX_MATCHES = 2000;
+    const uint8_t PATTERN_LENS[] = { 1, 2, 6, 40 };
+    static uint8_t data[DATA_SIZE];
+    static uint8_t encoded_data[DATA_SIZE*2];
+    static size_t matches[MAX_MATCHES];
+    static size_t matches_ref[MAX_MATCHES];
+    uint8_t pattern[40];
+    CDPPatternSearch Search;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 17:\n\n");
+
+    for(uint8_t n = 0; n < sizeof(PATTERN_LENS); n++)
+    {
+        const uint8_t pattern_len = PATTERN_LENS[n];
+        uint8_t level = gen_random_byte() & 0x01;
+        uint8_t start_level = level;
+        size_t num_matches = 0;
+        size_t num_matches_ref = 0;
+
+        for(uint32_t i = 0; i < DATA_SIZE; i++)
+            data[i] = gen_random_byte();
+        for(uint8_t i = 0; i < pattern_len; i++)
+            pattern[i] = gen_random_byte();
+        for(uint16_t i = 0; i < NUM_PLACED; i++)
+        {
+            uint32_t position = (uint32_t)rand() % (DATA_SIZE - pattern_len);
+            memcpy(data + position, pattern, pattern_len);
+        }
+        memcpy(data + DATA_SIZE - pattern_len, pattern, pattern_len);
+        for(uint32_t i = 0; i + pattern_len <= DATA_SIZE; i++)
+        {
+            if((memcmp(data + i, pattern, pattern_len) == 0) &&
+               (num_matches_ref < MAX_MATCHES))
+            {
+                matches_ref[num_matches_ref] = i;
+                num_matches_ref = num_matches_ref + 1;
+            }
+        }
+
+        Cdp.encode(data, DATA_SIZE, encoded_data, sizeof(encoded_data),
+                &level);
+        Search.setup(pattern, pattern_len);
+        num_matches = Search.find(encoded_data, sizeof(encoded_data),
+                start_level, 0, matches, MAX_MATCHES);
+        if((num_matches != num_matches_ref) ||
+           (memcmp(matches, matches_ref, num_matches*sizeof(size_t)) != 0))
+        {
+            printf("Pattern %d bytes - FAIL! %zu matches, expected %zu.\n",
+                    pattern_len, num_matches, num_matches_ref);
+            return false;
+        }
+        printf("Pattern %d bytes - Ok, %zu matches.\n", pattern_len,
+                num_matches);
+    }
+    printf("\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test encoded data concat and slice: random data segments are
+  * encoded one by one and appended to an encoded stream, and random ranges
+  * are cut from it, and both must be the same as the encode of the joined
+  * data and of the data ranges.
+  * @return Test result.
+  */
+bool test16(void)
+{
+    const uint16_t NUM_SEGMENTS = 200;
+    const uint16_t MAX_SEGMENT_SIZE = 500;
+    static uint8_t data[NUM_SEGMENTS*MAX_SEGMENT_SIZE];
+    static uint8_t encoded_data[NUM_SEGMENTS*MAX_SEGMENT_SIZE*2];
+    static uint8_t encoded_segment[MAX_SEGMENT_SIZE*2];
+    static uint8_t encoded_ref[NUM_SEGMENTS*MAX_SEGMENT_SIZE*2];
+    size_t len = 0;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 16:\n\n");
+
+    // Append segments encoded separately
+    for(uint16_t n = 0; n < NUM_SEGMENTS; n++)
+    {
+        uint16_t segment_len = (uint16_t)(rand() % MAX_SEGMENT_SIZE) + 1;
+
+        for(uint16_t i = 0; i < segment_len; i++)
+            data[len + i] = gen_random_byte();
+        Cdp.encode(data + len, segment_len, encoded_segment,
+                sizeof(encoded_segment));
+        if(Cdp.concat(encoded_data, len*2, encoded_segment, segment_len*2,
+                encoded_data, sizeof(encoded_data)) == false)
+        {
+            printf("Segment %d - FAIL! Concat error.\n", n);
+            return false;
+        }
+        len = len + segment_len;
+    }
+    Cdp.encode(data, len, encoded_ref, sizeof(encoded_ref));
+    if(memcmp(encoded_data, encoded_ref, len*2) != 0)
+    {
+        printf("FAIL! Concat encoded data != encoded data.\n");
+        return false;
+    }
+    printf("Ok, concat encoded data == encoded data.\n");
+
+    // Cut random ranges
+    for(uint16_t n = 0; n < NUM_SEGMENTS; n++)
+    {
+        size_t position = (size_t)rand() % (len + 1);
+        size_t range_len = (size_t)rand() % (MAX_SEGMENT_SIZE + 1);
+
+        if(range_len > len - position)
+            range_len = len - position;
+        Cdp.encode(data + position, range_len, encoded_ref,
+                sizeof(encoded_ref));
+        if((Cdp.slice(encoded_data, len*2, position*2, range_len*2,
+                encoded_segment, sizeof(encoded_segment)) == false) ||
+           (memcmp(encoded_segment, encoded_ref, range_len*2) != 0))
+        {
+            printf("Range %d - FAIL! Slice encoded data != encoded data.\n",
+                    n);
+            return false;
+        }
+    }
+    printf("Ok, slice encoded data == encoded data.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test rope encoded buffer: random inserts, erases and overwrites
+  * are applied to a rope and to a plain data array, and the rope encoded
+  * data (whole and partial reads) and end level must be the same as the
+  * encode of the data array. Small chunks must be coalesced (no more than
+  * two chunks for each ROPE_CHUNK_SIZE bytes).
+  * @return Test result.
+  */
+bool test15(void)
+{
+    const uint32_t LOAD_SIZE = 200000;
+    const uint32_t MAX_SIZE = 400000;
+    const uint16_t MAX_EDIT_SIZE = 3000;
+    const uint16_t NUM_EDITS = 600;
+    const uint16_t CHECK_PERIOD = 50;
+    static uint8_t data[MAX_SIZE];
+    static uint8_t edit[MAX_EDIT_SIZE];
+    static uint8_t encoded_data[MAX_SIZE*2];
+    static uint8_t encoded_ref[MAX_SIZE*2];
+    static CDPRope Rope;
+    uint8_t start_level = gen_random_byte() & 0x01;
+    uint32_t len = LOAD_SIZE;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 15:\n\n");
+
+    for(uint32_t i = 0; i < LOAD_SIZE; i++)
+        data[i] = gen_random_byte();
+    Rope.load(data, LOAD_SIZE, start_level);
+
+    for(uint16_t n = 1; n <= NUM_EDITS; n++)
+    {
+        uint16_t edit_len = (uint16_t)(rand() % MAX_EDIT_SIZE) + 1;
+        uint32_t position = (uint32_t)rand() % (len + 1);
+        uint8_t op = (uint8_t)(rand() % 3);
+        bool ok = true;
+
+        for(uint16_t i = 0; i < edit_len; i++)
+            edit[i] = gen_random_byte();
+        if((op == 0) && (len + edit_len <= MAX_SIZE))
+        {
+            ok = Rope.insert(position, edit, edit_len);
+            memmove(data + position + edit_len, data + position,
+                    len - position);
+            memcpy(data + position, edit, edit_len);
+            len = len + edit_len;
+        }
+        else
+        {
+            if(edit_len > len - position)
+                edit_len = (uint16_t)(len - position);
+            if(op == 1)
+            {
+                ok = Rope.erase(position, edit_len);
+                memmove(data + position, data + position + edit_len,
+                        len - position - edit_len);
+                len = len - edit_len;
+            }
+            else
+            {
+                ok = Rope.write(position, edit, edit_len);
+                memcpy(data + position, edit, edit_len);
+            }
+        }
+        if((ok == false) || (Rope.get_len() != len))
+        {
+            printf("Edit %d - FAIL! Edit error.\n", n);
+            return false;
+        }
+        if((n % CHECK_PERIOD) != 0)
+            continue;
+
+        // Check whole encoded data and end level
+        uint8_t level = start_level;
+        Cdp.encode(data, len, encoded_ref, len*2, &level);
+        if((Rope.read(0, len, encoded_data, sizeof(encoded_data)) == false) ||
+           (memcmp(encoded_data, encoded_ref, len*2) != 0) ||
+           (Rope.get_end_level() != level))
+        {
+            printf("Edit %d - FAIL! Rope encoded data != encoded data.\n",
+                    n);
+            return false;
+        }
+
+        // Check a partial read
+        position = (uint32_t)rand() % (len + 1);
+        edit_len = (uint16_t)(rand() % MAX_EDIT_SIZE);
+        if(edit_len > len - position)
+            edit_len = (uint16_t)(len - position);
+        if((Rope.read(position, edit_len, encoded_data,
+                sizeof(encoded_data)) == false) ||
+           (memcmp(encoded_data, encoded_ref + position*2, edit_len*2) != 0))
+        {
+            printf("Edit %d - FAIL! Rope partial read != encoded data.\n",
+                    n);
+            return false;
+        }
+    }
+    if(Rope.get_num_chunks() > (2*(uint64_t)len / ROPE_CHUNK_SIZE) + 1)
+    {
+        printf("Error, %" PRIu64 " rope chunks for %" PRIu32 " bytes.\n\n",
+                Rope.get_num_chunks(), len);
+        return false;
+    }
+    printf("Ok, rope encoded data == encoded data (%" PRIu32 " bytes, "
+            "%" PRIu64 " chunks).\n\n", len, Rope.get_num_chunks());
+
+    return true;
+}
+
+/**
+  * @brief  Test frame templates: frames sent from a template with random
+  * values of its variable fields (AC, part of DA, a sequence number and a
+  * 100 bytes block of the payload) and random starting levels must be the
+  * same as the frames built with those values. Frames sent from a template
+  * with a field covering AC and FC must be the same too.
+  * @return Test result.
+  */
+bool test14(void)
+{
+    const uint16_t PAYLOAD_SIZE = 300;
+    const uint16_t NUM_SENDS = 200;
+    const cdp_template_field_t FIELDS[] =
+    {
+        { FRAME_AC_OFFSET, 1 },
+        { FRAME_DA_OFFSET + 4, 2 },
+        { FRAME_PAYLOAD_OFFSET + 10, 2 },
+        { FRAME_PAYLOAD_OFFSET + 150, 100 }
+    };
+    const uint8_t NUM_FIELDS = sizeof(FIELDS) / sizeof(cdp_template_field_t);
+    const cdp_template_field_t AC_FC_FIELDS[] =
+    {
+        { FRAME_AC_OFFSET, 2 },
+        { FRAME_DA_OFFSET + 4, 2 },
+        { FRAME_PAYLOAD_OFFSET + 10, 2 },
+        { FRAME_PAYLOAD_OFFSET + 150, 100 }
+    };
+    static uint8_t frame[FRAME_OVERHEAD_LEN + PAYLOAD_SIZE];
+    static uint8_t values[NUM_FIELDS][100];
+    static uint8_t encoded_data[(FRAME_OVERHEAD_LEN + PAYLOAD_SIZE)*2];
+    static uint8_t encoded_ref[(FRAME_OVERHEAD_LEN + PAYLOAD_SIZE)*2];
+    static CDPFrameTemplate Template;
+    static CDPFrameTemplate AcFcTemplate;
+    const uint8_t* values_ptrs[NUM_FIELDS];
+    const uint8_t* ac_fc_values_ptrs[NUM_FIELDS];
+    uint8_t fc = 0;
+    CDPFrame Frame;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 14:\n\n");
+
+    for(uint16_t i = 0; i < sizeof(frame); i++)
+        frame[i] = gen_random_byte();
+    fc = frame[FRAME_FC_OFFSET];
+    for(uint8_t i = 0; i < NUM_FIELDS; i++)
+    {
+        values_ptrs[i] = values[i];
+        ac_fc_values_ptrs[i] = frame + AC_FC_FIELDS[i].offset;
+    }
+    if(Template.compile(frame[FRAME_AC_OFFSET], frame[FRAME_FC_OFFSET],
+            frame + FRAME_DA_OFFSET, frame + FRAME_SA_OFFSET,
+            frame + FRAME_PAYLOAD_OFFSET, PAYLOAD_SIZE, FIELDS,
+            NUM_FIELDS) == false)
+    {
+        printf("Error compiling template.\n");
+        return false;
+    }
+    if(AcFcTemplate.compile(frame[FRAME_AC_OFFSET], frame[FRAME_FC_OFFSET],
+            frame + FRAME_DA_OFFSET, frame + FRAME_SA_OFFSET,
+            frame + FRAME_PAYLOAD_OFFSET, PAYLOAD_SIZE, AC_FC_FIELDS,
+            NUM_FIELDS) == false)
+    {
+        printf("Error compiling AC and FC field template.\n");
+        return false;
+    }
+
+    for(uint16_t n = 0; n < NUM_SENDS; n++)
+    {
+        uint8_t level = gen_random_byte() & 0x01;
+        uint8_t ref_level = level;
+        uint8_t ac_fc_level = gen_random_byte() & 0x01;
+
+        for(uint8_t i = 0; i < NUM_FIELDS; i++)
+        {
+            for(uint16_t j = 0; j < FIELDS[i].len; j++)
+            {
+                values[i][j] = gen_random_byte();
+                frame[FIELDS[i].offset + j] = values[i][j];
+            }
+        }
+        if(Template.send(values_ptrs, encoded_data, sizeof(encoded_data),
+                &level) == false)
+        {
+            printf("Error sending from template.\n");
+            return false;
+        }
+        Frame.build(frame[FRAME_AC_OFFSET], frame[FRAME_FC_OFFSET],
+                frame + FRAME_DA_OFFSET, frame + FRAME_SA_OFFSET,
+                frame + FRAME_PAYLOAD_OFFSET, PAYLOAD_SIZE, encoded_ref,
+                sizeof(encoded_ref), &ref_level);
+        if((level != ref_level) ||
+           (Template.get_encoded_len() != sizeof(encoded_ref)) ||
+           (memcmp(encoded_data, encoded_ref, sizeof(encoded_ref)) != 0))
+        {
+            printf("Send %d - FAIL! Template frame != built frame.\n", n);
+            return false;
+        }
+
+        // AC and FC field (FC byte changes the FCS, AC does not)
+        frame[FRAME_FC_OFFSET] = gen_random_byte();
+        level = ac_fc_level;
+        Frame.build(frame[FRAME_AC_OFFSET], frame[FRAME_FC_OFFSET],
+                frame + FRAME_DA_OFFSET, frame + FRAME_SA_OFFSET,
+                frame + FRAME_PAYLOAD_OFFSET, PAYLOAD_SIZE, encoded_ref,
+                sizeof(encoded_ref), &ac_fc_level);
+        if((AcFcTemplate.send(ac_fc_values_ptrs, encoded_data,
+                sizeof(encoded_data), &level) == false) ||
+           (level != ac_fc_level) ||
+           (memcmp(encoded_data, encoded_ref, sizeof(encoded_ref)) != 0))
+        {
+            printf("Send %d - FAIL! AC and FC field template frame != "
+                    "built frame.\n", n);
+            return false;
+        }
+        frame[FRAME_FC_OFFSET] = fc;
+    }
+    printf("Ok, template frames == built frames.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test encode cache: a few repeated frames (data and J/K symbols)
+  * are encoded through the cache with random starting levels, and must
+  * give the same chips and levels as CDP, with exactly one miss for each
+  * different frame (and one for each encode of the too long one). More
+  * different frames than cache entries in round robin (the worst case for
+  * LRU) must miss always, and long data bypass the cache.
+  * @return Test result.
+  */
+bool test13(void)
+{
+    const uint16_t NUM_FRAMES = 10;
+    const uint16_t NUM_ENCODES = 5000;
+    const uint16_t MAX_DATA_SIZE = CACHE_MAX_DATA_LEN + 16;
+    static uint8_t data[CACHE_ENTRIES*2][MAX_DATA_SIZE];
+    static uint8_t jk[CACHE_ENTRIES*2][MAX_DATA_SIZE];
+    static uint16_t data_sizes[CACHE_ENTRIES*2];
+    static uint8_t encoded_data[MAX_DATA_SIZE*2];
+    static uint8_t encoded_ref[MAX_DATA_SIZE*2];
+    static CDPEncodeCache Cache;
+    uint64_t long_count = 0;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 13:\n\n");
+
+    // Frames (odd ones with J/K symbols, last one too long to be cached)
+    for(uint16_t f = 0; f < CACHE_ENTRIES*2; f++)
+    {
+        data_sizes[f] = 1 + (gen_random_byte() % 64);
+        for(uint16_t i = 0; i < MAX_DATA_SIZE; i++)
+        {
+            data[f][i] = gen_random_byte();
+            jk[f][i] = (f % 2) ? gen_random_byte() : 0x00;
+        }
+    }
+    data_sizes[NUM_FRAMES - 1] = MAX_DATA_SIZE;
+
+    for(uint16_t n = 0; n < NUM_ENCODES; n++)
+    {
+        uint16_t f = gen_random_byte() % NUM_FRAMES;
+        uint8_t level = gen_random_byte() & 0x01;
+        uint8_t ref_level = level;
+        if(f == NUM_FRAMES - 1)
+            long_count = long_count + 1;
+        if(f % 2)
+        {
+            Cache.encode_symbols(data[f], jk[f], data_sizes[f], encoded_data,
+                    sizeof(encoded_data), &level);
+            Cdp.encode_symbols(data[f], jk[f], data_sizes[f], encoded_ref,
+                    sizeof(encoded_ref), &ref_level);
+        }
+        else
+        {
+            Cache.encode(data[f], data_sizes[f], encoded_data,
+                    sizeof(encoded_data), &level);
+            Cdp.encode(data[f], data_sizes[f], encoded_ref,
+                    sizeof(encoded_ref), &ref_level);
+        }
+        if((level != ref_level) ||
+           (memcmp(encoded_data, encoded_ref, data_sizes[f]*2) != 0))
+        {
+            printf("Encode %d - FAIL! Cached encode != encode.\n", n);
+            return false;
+        }
+    }
+    if(Cache.get_hits() + Cache.get_misses() != NUM_ENCODES)
+    {
+        printf("Error, wrong number of cache hits and misses.\n");
+        return false;
+    }
+    if(Cache.get_misses() != (NUM_FRAMES - 1) + long_count)
+    {
+        printf("Error, cache misses != different frames + long frames.\n");
+        return false;
+    }
+    printf("Ok, cached encodes == encodes (%" PRIu64 " hits, %" PRIu64
+            " misses).\n", Cache.get_hits(), Cache.get_misses());
+
+    // Round robin over more frames than entries
+    Cache.reset();
+    for(uint16_t n = 0; n < CACHE_ENTRIES*2*4; n++)
+    {
+        uint16_t f = n % (CACHE_ENTRIES*2);
+        uint8_t level = LOGIC_LEVEL_HIGH;
+        Cache.encode(data[f], data_sizes[f], encoded_data,
+                sizeof(encoded_data), &level);
+    }
+    if((Cache.get_hits() != 0) || (Cache.get_misses() != CACHE_ENTRIES*2*4))
+    {
+        printf("Error, unexpected LRU hits.\n");
+        return false;
+    }
+    printf("Ok, LRU replacement.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test frame-level parallel capture decode: a capture with tokens,
+  * tiny frames and 4 KiB frames (some of them corrupted) at random chip
+  * positions is decoded with several threads. Results must be in capture
+  * order, with the frames data and the expected result for each one, and
+  * the same as a single thread decode.
+  * @return Test result.
+  */
+bool test12(void)
+{
+    const uint16_t NUM_FRAMES = 400;
+    const uint16_t LARGE_PAYLOAD_SIZE = 4096;
+    const uint16_t MAX_SMALL_PAYLOAD_SIZE = 64;
+    const uint16_t MAX_FILLER_SIZE = 16;
+    const uint32_t CAPTURE_SIZE = (NUM_FRAMES / 4) *
+            ((FRAME_OVERHEAD_LEN + LARGE_PAYLOAD_SIZE) +
+             (FRAME_OVERHEAD_LEN + MAX_SMALL_PAYLOAD_SIZE)*2 +
+             FRAME_TOKEN_LEN + MAX_FILLER_SIZE*4) * 2;
+    static uint8_t capture[CAPTURE_SIZE] = { 0 };
+    static uint8_t encoded_data[(FRAME_OVERHEAD_LEN + LARGE_PAYLOAD_SIZE)*2];
+    static uint8_t payloads[NUM_FRAMES][LARGE_PAYLOAD_SIZE];
+    static uint16_t payload_sizes[NUM_FRAMES];
+    static uint8_t expected[NUM_FRAMES];
+    static uint8_t decoded_data[CAPTURE_SIZE / 2];
+    static uint8_t decoded_ref[CAPTURE_SIZE / 2];
+    static cdp_frame_result_t results[NUM_FRAMES];
+    static cdp_frame_result_t results_ref[NUM_FRAMES];
+    static CDPParallelDecoder Decoder;
+    uint8_t filler[MAX_FILLER_SIZE];
+    uint8_t da[FRAME_ADDR_LEN] = { 0x40, 0x00, 0x00, 0x00, 0x00, 0x01 };
+    uint8_t sa[FRAME_ADDR_LEN] = { 0x40, 0x00, 0x00, 0x00, 0x00, 0x02 };
+    uint8_t token[FRAME_TOKEN_LEN] = { DELIMITER_SD_DATA, 0x00,
+            DELIMITER_ED_DATA };
+    uint8_t token_jk[FRAME_TOKEN_LEN] = { DELIMITER_SD_JK, 0x00,
+            DELIMITER_ED_JK };
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    uint64_t num_chips = 0;
+    CDPFrame Frame;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 12:\n\n");
+
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        uint16_t filler_size = 1 + (gen_random_byte() % MAX_FILLER_SIZE);
+        uint8_t filler_bits = 1 + (gen_random_byte() % 8);
+        size_t encoded_len = FRAME_TOKEN_LEN*2;
+
+        for(uint16_t i = 0; i < filler_size; i++)
+            filler[i] = gen_random_byte();
+        Cdp.encode(filler, filler_size, encoded_data, filler_size*2,
+                &signal_level);
+        num_chips = append_chips(capture, num_chips, encoded_data,
+                (filler_size - 1)*16 + filler_bits*2);
+        signal_level = (capture[(num_chips - 1) / 8] >>
+                ((num_chips - 1) % 8)) & 1;
+
+        // Token, 4 KiB frame or tiny frame
+        payload_sizes[f] = 0;
+        expected[f] = FRAME_RESULT_OK;
+        if(f % 4 == 0)
+        {
+            Cdp.encode_symbols(token, token_jk, FRAME_TOKEN_LEN,
+                    encoded_data, encoded_len, &signal_level);
+            expected[f] = FRAME_RESULT_TOKEN;
+        }
+        else
+        {
+            payload_sizes[f] = LARGE_PAYLOAD_SIZE;
+            if(f % 4 != 1)
+                payload_sizes[f] = gen_random_byte() % MAX_SMALL_PAYLOAD_SIZE;
+            for(uint16_t i = 0; i < payload_sizes[f]; i++)
+                payloads[f][i] = gen_random_byte();
+            encoded_len = CDPFrame::get_encoded_len(payload_sizes[f]);
+            Frame.build(0x10, 0x40, da, sa, payloads[f], payload_sizes[f],
+                    encoded_data, encoded_len, &signal_level);
+
+            // Corrupt some frames (invert a data symbol of the header)
+            if(f % 7 == 0)
+            {
+                encoded_data[2 + 4] ^= 0x03;
+                expected[f] = FRAME_RESULT_FCS_ERROR;
+            }
+        }
+        num_chips = append_chips(capture, num_chips, encoded_data,
+                encoded_len*8);
+    }
+
+    // Single thread reference and multiple threads decode
+    if((Decoder.setup(1) == false) ||
+       (Decoder.decode(capture, num_chips, decoded_ref, sizeof(decoded_ref),
+            results_ref, NUM_FRAMES) != NUM_FRAMES))
+    {
+        printf("Error, unexpected number of frames decoded.\n");
+        return false;
+    }
+    if((Decoder.setup(4) == false) ||
+       (Decoder.decode(capture, num_chips, decoded_data, sizeof(decoded_data),
+            results, NUM_FRAMES) != NUM_FRAMES))
+    {
+        printf("Error, unexpected number of frames decoded.\n");
+        return false;
+    }
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        cdp_frame_result_t* result = &(results[f]);
+        if((result->result != expected[f]) ||
+           (result->data != results_ref[f].data) ||
+           (result->result != results_ref[f].result) ||
+           (memcmp(decoded_data + result->data, decoded_ref + result->data,
+                result->data_len) != 0))
+        {
+            printf("Frame %d - FAIL! Wrong result.\n", f);
+            return false;
+        }
+        if((expected[f] == FRAME_RESULT_OK) &&
+           ((result->view.payload_len != payload_sizes[f]) ||
+            (memcmp(decoded_data + result->view.payload, payloads[f],
+                payload_sizes[f]) != 0)))
+        {
+            printf("Frame %d - FAIL! Wrong payload.\n", f);
+            return false;
+        }
+    }
+    printf("Ok, %d frames decoded in capture order.\n\n", NUM_FRAMES);
+
+    return true;
+}
+
+/**
+  * @brief  Test token ring simulation: rings with stations on several
+  * threads (with and without early token release) must get back all the
+  * frames sent, all copied by their destination without FCS errors.
+  * @return Test result.
+  */
+bool test11(void)
+{
+    const uint8_t NUM_STATIONS = 8;
+    const uint8_t NUM_THREADS = 4;
+    const uint32_t FRAMES_PER_STATION = 50;
+    const uint16_t PAYLOAD_SIZE = 256;
+    static CDPRing Ring;
+    cdp_ring_stats_t stats;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 11:\n\n");
+
+    for(uint8_t early_token_release = 0; early_token_release < 2;
+            early_token_release++)
+    {
+        if((Ring.setup(NUM_STATIONS, NUM_THREADS, FRAMES_PER_STATION,
+                PAYLOAD_SIZE, early_token_release) == false) ||
+           (Ring.run(&stats) == false))
+        {
+            printf("Error running ring simulation.\n");
+            return false;
+        }
+        if((stats.frames != NUM_STATIONS*FRAMES_PER_STATION) ||
+           (stats.frames_copied != stats.frames) ||
+           (stats.frames_errors != 0))
+        {
+            printf("Error, frames lost or not copied.\n");
+            return false;
+        }
+        printf("Ok, %" PRIu64 " frames (early token release %d): "
+                "%.0f frames/s, %.0f chips/s, hop latency %.1f us "
+                "(max %.1f us).\n", stats.frames, early_token_release,
+                stats.frames_per_second, stats.chips_per_second,
+                stats.hop_latency_avg_us, stats.hop_latency_max_us);
+    }
+    printf("\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test frames parse: thousands of frames (some with routing
+  * information) are built with data filler between them, the capture is
+  * decoded and all frames views are got in one batch parse. Views must
+  * point to each frame fields, and a corrupted frame must fail the FCS.
+  * @return Test result.
+  */
+bool test10(void)
+{
+    const uint16_t NUM_FRAMES = 2000;
+    const uint16_t MAX_PAYLOAD_SIZE = 64;
+    const uint16_t MAX_FILLER_SIZE = 8;
+    const uint32_t CAPTURE_SIZE = NUM_FRAMES * (FRAME_OVERHEAD_LEN +
+            MAX_PAYLOAD_SIZE + MAX_FILLER_SIZE);
+    static uint8_t encoded_data[CAPTURE_SIZE*2] = { 0 };
+    static uint8_t decoded_data[CAPTURE_SIZE] = { 0 };
+    static uint8_t decoded_jk[CAPTURE_SIZE] = { 0 };
+    static uint8_t payloads[NUM_FRAMES * MAX_PAYLOAD_SIZE] = { 0 };
+    static uint16_t payload_sizes[NUM_FRAMES] = { 0 };
+    static cdp_frame_view_t views[NUM_FRAMES];
+    uint8_t filler[MAX_FILLER_SIZE] = { 0 };
+    uint8_t da[FRAME_ADDR_LEN] = { 0 };
+    uint8_t sa[FRAME_ADDR_LEN] = { 0 };
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    size_t encoded_len = 0;
+    cdp_frame_view_t view;
+    CDPFrame Frame;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 10:\n\n");
+
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        uint8_t* payload = payloads + f*MAX_PAYLOAD_SIZE;
+        uint16_t filler_size = gen_random_byte() % (MAX_FILLER_SIZE + 1);
+        uint16_t payload_size = gen_random_byte() % (MAX_PAYLOAD_SIZE + 1);
+
+        for(uint16_t i = 0; i < filler_size; i++)
+            filler[i] = gen_random_byte();
+        Cdp.encode(filler, filler_size, encoded_data + encoded_len,
+                filler_size*2, &signal_level);
+        encoded_len = encoded_len + filler_size*2;
+
+        // Routing information (2 to 18 bytes) at the payload start
+        for(uint8_t i = 0; i < FRAME_ADDR_LEN; i++)
+        {
+            da[i] = gen_random_byte();
+            sa[i] = gen_random_byte() & ~FRAME_SA_RII_BIT;
+        }
+        for(uint16_t i = 0; i < payload_size; i++)
+            payload[i] = gen_random_byte();
+        if((f % 3 == 0) && (payload_size >= 18))
+        {
+            sa[0] = sa[0] | FRAME_SA_RII_BIT;
+            payload[0] = 2 + 2*(gen_random_byte() % 9);
+        }
+        payload_sizes[f] = payload_size;
+
+        Frame.build(gen_random_byte(), gen_random_byte(), da, sa, payload,
+                payload_size, encoded_data + encoded_len,
+                CDPFrame::get_encoded_len(payload_size), &signal_level);
+        encoded_len = encoded_len + CDPFrame::get_encoded_len(payload_size);
+    }
+
+    signal_level = INITIAL_SIGNAL_LEVEL;
+    Cdp.decode_symbols(encoded_data, encoded_len, decoded_data, decoded_jk,
+            sizeof(decoded_data), &signal_level);
+    if(Frame.parse_batch(decoded_data, decoded_jk, encoded_len / 2, views,
+            NUM_FRAMES) != NUM_FRAMES)
+    {
+        printf("Error, unexpected number of frames parsed.\n");
+        return false;
+    }
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        uint8_t* payload = payloads + f*MAX_PAYLOAD_SIZE;
+        if((views[f].fcs_ok == false) ||
+           (views[f].ri_len + views[f].payload_len != payload_sizes[f]) ||
+           (memcmp(decoded_data + views[f].ri, payload, payload_sizes[f])
+                != 0) ||
+           (decoded_data[views[f].sa] & FRAME_SA_RII_BIT) !=
+                ((views[f].ri_len > 0) ? FRAME_SA_RII_BIT : 0))
+        {
+            printf("Frame %d - FAIL! Wrong view.\n", f);
+            return false;
+        }
+    }
+    printf("Ok, %d frames parsed.\n", NUM_FRAMES);
+
+    // Corrupted frame
+    decoded_data[views[NUM_FRAMES/2].fc] ^= 0x01;
+    if((Frame.parse(decoded_data + views[NUM_FRAMES/2].ac,
+            views[NUM_FRAMES/2].frame_len, &view) == false) ||
+       (view.fcs_ok == true))
+    {
+        printf("Error, corrupted frame passes the FCS check.\n");
+        return false;
+    }
+    printf("Ok, corrupted frame detected.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test frames build: frames with random fields and payload sizes
+  * are built and compared with the frame assembled by hand (FCS computed
+  * bit by bit) and encoded with encode_symbols(). The decoded frame must
+  * give the CRC-32 residue over FC to FCS.
+  * @return Test result.
+  */
+bool test9(void)
+{
+    const uint16_t MAX_PAYLOAD_SIZE = 1500;
+    const uint16_t PAYLOAD_SIZES[] = { 0, 1, 63, 64, 513, 1024,
+            MAX_PAYLOAD_SIZE };
+    const uint32_t FRAME_SIZE = FRAME_OVERHEAD_LEN + MAX_PAYLOAD_SIZE;
+    static uint8_t frame[FRAME_SIZE] = { 0 };
+    static uint8_t jk[FRAME_SIZE] = { 0 };
+    static uint8_t encoded_data[FRAME_SIZE*2] = { 0 };
+    static uint8_t encoded_ref[FRAME_SIZE*2] = { 0 };
+    static uint8_t decoded_data[FRAME_SIZE] = { 0 };
+    static uint8_t decoded_jk[FRAME_SIZE] = { 0 };
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    uint8_t ref_signal_level = INITIAL_SIGNAL_LEVEL;
+    CDPFrame Frame;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 9:\n\n");
+
+    for(uint8_t n = 0; n < sizeof(PAYLOAD_SIZES)/sizeof(uint16_t); n++)
+    {
+        const uint16_t payload_size = PAYLOAD_SIZES[n];
+        const size_t frame_size = FRAME_OVERHEAD_LEN + payload_size;
+        uint8_t* payload = frame + 1 + FRAME_HEADER_LEN;
+        uint8_t* fcs = payload + payload_size;
+        uint8_t frame_signal_level = signal_level;
+        uint32_t crc = 0xFFFFFFFF;
+
+        // Frame assembled by hand
+        memset(jk, 0, frame_size);
+        for(size_t i = 0; i < frame_size; i++)
+            frame[i] = gen_random_byte();
+        frame[0] = DELIMITER_SD_DATA; jk[0] = DELIMITER_SD_JK;
+        for(uint8_t* p = frame + 2; p < fcs; p++)
+        {
+            crc = crc ^ *p;
+            for(uint8_t bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+        crc = ~crc;
+        for(uint8_t i = 0; i < 4; i++)
+            fcs[i] = (uint8_t)(crc >> (8*i));
+        fcs[4] = DELIMITER_ED_DATA; jk[frame_size-2] = DELIMITER_ED_JK;
+        fcs[5] = 0x00;
+
+        if(Frame.build(frame[1], frame[2], frame + 3, frame + 3 +
+                FRAME_ADDR_LEN, payload, payload_size, encoded_data,
+                sizeof(encoded_data), &signal_level) == false)
+        {
+            printf("Error building frame.\n");
+            return false;
+        }
+        Cdp.encode_symbols(frame, jk, frame_size, encoded_ref,
+                sizeof(encoded_ref), &ref_signal_level);
+        if((memcmp(encoded_data, encoded_ref, frame_size*2) != 0) ||
+           (signal_level != ref_signal_level) ||
+           (CDPFrame::get_encoded_len(payload_size) != frame_size*2))
+        {
+            printf("Payload %d - FAIL! Built frame != reference.\n",
+                    payload_size);
+            return false;
+        }
+
+        // Decoded frame check sequence
+        Cdp.decode_symbols(encoded_data, frame_size*2, decoded_data,
+                decoded_jk, sizeof(decoded_data), &frame_signal_level);
+        if((memcmp(decoded_data, frame, frame_size) != 0) ||
+           (crc32_update(CRC32_INIT, decoded_data + 2,
+                frame_size - 4) != CRC32_RESIDUE))
+        {
+            printf("Payload %d - FAIL! Wrong FCS.\n", payload_size);
+            return false;
+        }
+    }
+    printf("Ok, built frames == reference frames.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test starting and ending delimiters scan: frames are placed at
+  * random chip positions (any alignment and polarity) between random data
+  * filler, and the scanner must find exactly their delimiters and bounds.
+  * @return Test result.
+  */
+bool test8(void)
+{
+    const uint16_t NUM_FRAMES = 64;
+    const uint16_t MAX_PAYLOAD_SIZE = 32;
+    const uint16_t MAX_FILLER_SIZE = 16;
+    const uint32_t CAPTURE_SIZE = NUM_FRAMES *
+            (MAX_PAYLOAD_SIZE + MAX_FILLER_SIZE + 2) * 2 + 64;
+    static uint8_t capture[CAPTURE_SIZE] = { 0 };
+    static uint8_t data[MAX_PAYLOAD_SIZE + MAX_FILLER_SIZE + 2] = { 0 };
+    static uint8_t jk[MAX_PAYLOAD_SIZE + MAX_FILLER_SIZE + 2] = { 0 };
+    static uint8_t encoded_data[(MAX_PAYLOAD_SIZE + MAX_FILLER_SIZE + 2)*2];
+    static cdp_frame_bounds_t expected[NUM_FRAMES];
+    static cdp_frame_bounds_t frames[NUM_FRAMES];
+    static cdp_delimiter_t delimiters[NUM_FRAMES*2];
+    uint64_t num_chips = 0;
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    CDPDelimiterScanner Scanner;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 8:\n\n");
+
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        uint16_t filler_size = 1 + (gen_random_byte() % MAX_FILLER_SIZE);
+        uint16_t payload_size = gen_random_byte() % (MAX_PAYLOAD_SIZE + 1);
+        uint8_t filler_bits = 1 + (gen_random_byte() % 8);
+
+        // Random data filler of any number of bits
+        for(uint16_t i = 0; i < filler_size; i++)
+            data[i] = gen_random_byte();
+        Cdp.encode(data, filler_size, encoded_data, filler_size*2,
+                &signal_level);
+        num_chips = append_chips(capture, num_chips, encoded_data,
+                (filler_size - 1)*16 + filler_bits*2);
+        signal_level = (capture[(num_chips - 1) / 8] >>
+                ((num_chips - 1) % 8)) & 1;
+
+        // Frame (SD, payload, ED with random I and E bits)
+        memset(jk, 0, payload_size + 2);
+        data[0] = DELIMITER_SD_DATA; jk[0] = DELIMITER_SD_JK;
+        for(uint16_t i = 1; i <= payload_size; i++)
+            data[i] = gen_random_byte();
+        data[payload_size+1] = DELIMITER_ED_DATA |
+                (gen_random_byte() & (DELIMITER_ED_I_BIT|DELIMITER_ED_E_BIT));
+        jk[payload_size+1] = DELIMITER_ED_JK;
+        expected[f].start_chip = num_chips;
+        expected[f].end_chip = num_chips + (payload_size + 2)*16;
+        expected[f].level = signal_level;
+        expected[f].ed_bits = data[payload_size+1] &
+                (DELIMITER_ED_I_BIT|DELIMITER_ED_E_BIT);
+        Cdp.encode_symbols(data, jk, payload_size + 2, encoded_data,
+                (payload_size + 2)*2, &signal_level);
+        num_chips = append_chips(capture, num_chips, encoded_data,
+                (payload_size + 2)*16);
+    }
+
+    // Delimiters
+    if(Scanner.find_delimiters(capture, num_chips, 0, delimiters,
+            NUM_FRAMES*2) != NUM_FRAMES*2)
+    {
+        printf("Error, unexpected number of delimiters found.\n");
+        return false;
+    }
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        cdp_delimiter_t* sd = &(delimiters[2*f]);
+        cdp_delimiter_t* ed = &(delimiters[2*f+1]);
+        if((sd->type != DELIMITER_TYPE_SD) ||
+           (sd->chip != expected[f].start_chip) ||
+           (sd->level != expected[f].level) ||
+           (ed->type != DELIMITER_TYPE_ED) ||
+           (ed->chip != expected[f].end_chip - DELIMITER_CHIPS) ||
+           (ed->ed_bits != expected[f].ed_bits))
+        {
+            printf("Frame %d - FAIL! Wrong delimiters.\n", f);
+            return false;
+        }
+    }
+    printf("Ok, %d delimiters found.\n", NUM_FRAMES*2);
+
+    // Frames
+    if(Scanner.find_frames(capture, num_chips, frames, NUM_FRAMES)
+            != NUM_FRAMES)
+    {
+        printf("Error, unexpected number of frames found.\n");
+        return false;
+    }
+    for(uint16_t f = 0; f < NUM_FRAMES; f++)
+    {
+        if((frames[f].start_chip != expected[f].start_chip) ||
+           (frames[f].end_chip != expected[f].end_chip) ||
+           (frames[f].level != expected[f].level) ||
+           (frames[f].ed_bits != expected[f].ed_bits))
+        {
+            printf("Frame %d - FAIL! Wrong bounds.\n", f);
+            return false;
+        }
+    }
+    printf("Ok, %d frames found.\n\n", NUM_FRAMES);
+
+    return true;
+}
+
+/**
+  * @brief  Test IEEE 802.5 J/K symbols encode-decode: a frame with starting
+  * and ending delimiters is encoded, J/K chips are checked to have no
+  * transitions, and the decode reports the same data and J/K positions.
+  * Data between delimiters must encode as encode() does.
+  * @return Test result.
+  */
+bool test7(void)
+{
+    const uint16_t DATA_SIZE = 259;
+    static uint8_t data[DATA_SIZE] = { 0 };
+    static uint8_t jk[DATA_SIZE] = { 0 };
+    static uint8_t encoded_data[DATA_SIZE*2] = { 0 };
+    static uint8_t encoded_ref[DATA_SIZE*2] = { 0 };
+    static uint8_t decoded_data[DATA_SIZE] = { 0 };
+    static uint8_t decoded_jk[DATA_SIZE] = { 0 };
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    uint8_t ref_signal_level = INITIAL_SIGNAL_LEVEL;
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 7:\n\n");
+
+    // Starting delimiter (JK0JK000), data and ending delimiter (JK1JK1IE)
+    for(uint32_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+    data[0] = 0x12; jk[0] = 0x1B;
+    data[DATA_SIZE-1] = 0x36; jk[DATA_SIZE-1] = 0x1B;
+
+    if(Cdp.encode_symbols(data, jk, DATA_SIZE, encoded_data, DATA_SIZE*2,
+            &signal_level) == false)
+    {
+        printf("Error encoding symbols.\n");
+        return false;
+    }
+
+    // Check J/K chips (no middle transition; J keeps level, K inverts it)
+    for(uint32_t i = 0; i < DATA_SIZE*8; i++)
+    {
+        uint8_t c1 = (encoded_data[(2*i) / 8] >> ((2*i) % 8)) & 1;
+        uint8_t c2 = (encoded_data[(2*i+1) / 8] >> ((2*i+1) % 8)) & 1;
+        uint8_t prev = INITIAL_SIGNAL_LEVEL;
+        if(i > 0)
+            prev = (encoded_data[(2*i-1) / 8] >> ((2*i-1) % 8)) & 1;
+        if(((jk[i / 8] >> (i % 8)) & 1) == 0)
+        {
+            if(c1 == c2)
+            {
+                printf("Bit %d - FAIL! Data bit without transition.\n", i);
+                return false;
+            }
+            continue;
+        }
+        if((c1 != c2) || ((c1 == prev) != (((data[i / 8] >> (i % 8)) & 1)
+                == SYMBOL_J_BIT)))
+        {
+            printf("Bit %d - FAIL! Wrong J/K symbol chips.\n", i);
+            return false;
+        }
+    }
+
+    // Data between delimiters as encode() from the level after the SD (its
+    // two K symbols invert the level twice)
+    ref_signal_level = INITIAL_SIGNAL_LEVEL;
+    Cdp.encode(data + 1, DATA_SIZE - 2, encoded_ref, (DATA_SIZE - 2)*2,
+            &ref_signal_level);
+    if(memcmp(encoded_ref, encoded_data + 2, (DATA_SIZE - 2)*2) != 0)
+    {
+        printf("Error, frame data encode != encode().\n");
+        return false;
+    }
+
+    signal_level = INITIAL_SIGNAL_LEVEL;
+    if(Cdp.decode_symbols(encoded_data, DATA_SIZE*2, decoded_data, decoded_jk,
+            DATA_SIZE, &signal_level) == false)
+    {
+        printf("Error decoding symbols.\n");
+        return false;
+    }
+    if((memcmp(decoded_data, data, DATA_SIZE) != 0) ||
+       (memcmp(decoded_jk, jk, DATA_SIZE) != 0))
+    {
+        printf("Error, decoded symbols != input symbols.\n\n");
+        return false;
+    }
+    printf("Ok, decoded symbols == input symbols.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test WAV waveform synthesis and soft decision decode: data is
+  * written in pieces (checking that encode with signal level continues the
+  * stream as encode() does) as int16 and float WAV files with rise time
+  * shaping, and decoded back, also after adding noise to the samples. A
+  * WAV file decoded while another one is being written must be decoded too,
+  * keeping the writer unflushed samples and sample rate.
+  * @return Test result.
+  */
+bool test6(void)
+{
+    const uint16_t DATA_SIZE = 1024;
+    const char* WAV_FILE = "test_wave.wav";
+    const char* WAV_REF_FILE = "test_wave_ref.wav";
+    const uint16_t FORMATS[] = { WAVE_FORMAT_PCM16, WAVE_FORMAT_FLOAT32,
+                                 WAVE_FORMAT_PCM16 };
+    const uint16_t SAMPLES_PER_CHIP[] = { 8, 5, 6 };
+    static uint8_t data[DATA_SIZE] = { 0 };
+    static uint8_t encoded_data[DATA_SIZE*2] = { 0 };
+    static uint8_t encoded_pieces[DATA_SIZE*2] = { 0 };
+    static uint8_t decoded_data[DATA_SIZE] = { 0 };
+    uint8_t signal_level = INITIAL_SIGNAL_LEVEL;
+    CDP Cdp;
+    static CDPWave Wave;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 6:\n\n");
+
+    // Check encode and decode with signal level in pieces
+    for(uint32_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+    Cdp.encode(data, DATA_SIZE, encoded_data, DATA_SIZE*2);
+    Cdp.encode(data, 100, encoded_pieces, 200, &signal_level);
+    Cdp.encode(data + 100, DATA_SIZE - 100, encoded_pieces + 200,
+            (DATA_SIZE - 100)*2, &signal_level);
+    signal_level = INITIAL_SIGNAL_LEVEL;
+    Cdp.decode(encoded_pieces, DATA_SIZE*2, decoded_data, DATA_SIZE,
+            &signal_level);
+    if((memcmp(encoded_pieces, encoded_data, DATA_SIZE*2) != 0) ||
+       (memcmp(decoded_data, data, DATA_SIZE) != 0))
+    {
+        printf("Error, encode/decode in pieces != encode()/decode().\n");
+        return false;
+    }
+
+    // Reference file to decode while writing the others
+    if((Wave.writer_open(WAV_REF_FILE, 44100, WAVE_FORMAT_PCM16, 8, 0.8,
+            2) == false) ||
+       (Wave.write(data, DATA_SIZE) == false) ||
+       (Wave.writer_close() == false))
+    {
+        printf("Error writing WAV file.\n");
+        return false;
+    }
+
+    for(uint8_t n = 0; n < 3; n++)
+    {
+        if((Wave.writer_open(WAV_FILE, 48000, FORMATS[n], SAMPLES_PER_CHIP[n],
+                0.8, 2) == false) ||
+           (Wave.write(data, 333) == false))
+        {
+            printf("Error writing WAV file.\n");
+            return false;
+        }
+
+        // Decode the reference file in the middle of the first write
+        if(n == 0)
+        {
+            bool result = false;
+            memset(decoded_data, 0, DATA_SIZE);
+            result = Wave.decode_file(WAV_REF_FILE, 8, decoded_data,
+                    DATA_SIZE, NULL, NULL);
+            remove(WAV_REF_FILE);
+            if((result == false) ||
+               (memcmp(decoded_data, data, DATA_SIZE) != 0))
+            {
+                printf("Error decoding WAV file while writing another.\n");
+                Wave.writer_close();
+                remove(WAV_FILE);
+                return false;
+            }
+        }
+        if((Wave.write(data + 333, DATA_SIZE - 333) == false) ||
+           (Wave.writer_close() == false))
+        {
+            printf("Error writing WAV file.\n");
+            return false;
+        }
+
+        // Add noise to the last int16 waveform
+        if(n == 2)
+        {
+            static uint8_t wav[44 + DATA_SIZE*16*6*2];
+            FILE* file = fopen(WAV_FILE, "r+b");
+            size_t wav_len = fread(wav, 1, sizeof(wav), file);
+            for(size_t i = 44; i + 1 < wav_len; i += 2)
+            {
+                int32_t sample = (int16_t)(wav[i] | (wav[i+1] << 8));
+                sample = sample + (rand() % 32768) - 16384;
+                if(sample > 32767) sample = 32767;
+                if(sample < -32768) sample = -32768;
+                wav[i] = (uint8_t)(sample & 0xff);
+                wav[i+1] = (uint8_t)((sample >> 8) & 0xff);
+            }
+            fseek(file, 0, SEEK_SET);
+            fwrite(wav, 1, wav_len, file);
+            fclose(file);
+        }
+
+        memset(decoded_data, 0, DATA_SIZE);
+        if(Wave.decode_file(WAV_FILE, SAMPLES_PER_CHIP[n], decoded_data,
+                DATA_SIZE, NULL, NULL) == false)
+        {
+            printf("Error decoding WAV file.\n");
+            remove(WAV_FILE);
+            return false;
+        }
+        remove(WAV_FILE);
+        if(Wave.get_sample_rate() != 48000)
+        {
+            printf("Error, WAV file sample rate != 48000.\n\n");
+            return false;
+        }
+        printf("%s, %d samples per chip%s: %zu bytes decoded.\n",
+               (FORMATS[n] == WAVE_FORMAT_PCM16) ? "int16" : "float",
+               SAMPLES_PER_CHIP[n], (n == 2) ? " (noise)" : "",
+               Wave.get_decoded_len());
+        if(memcmp(decoded_data, data, DATA_SIZE) != 0)
+        {
+            printf("Error, decoded data != input data.\n\n");
+            return false;
+        }
+    }
+    printf("Ok, decoded data == input data.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test oversampled encode for SPI/I2S transmit buffers: for each
+  * samples per chip value (1 to 16) and bit order, compare the expanded
+  * encode with a bit by bit expansion of encode() output.
+  * @return Test result.
+  */
+bool test5(void)
+{
+    const uint16_t DATA_SIZE = 257;
+    static uint8_t data[DATA_SIZE] = { 0 };
+    static uint8_t encoded_data[DATA_SIZE*2] = { 0 };
+    static uint8_t expanded_data[DATA_SIZE*2*16] = { 0 };
+    CDP Cdp;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 5:\n\n");
+
+    for(uint32_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+    if(Cdp.encode(data, DATA_SIZE, encoded_data, DATA_SIZE*2) == false)
+    {
+        printf("Error encoding data.\n");
+        return false;
+    }
+
+    for(uint8_t k = 1; k <= 16; k++)
+    {
+        for(uint8_t msb_first = 0; msb_first < 2; msb_first++)
+        {
+            if(Cdp.encode_oversampled(data, DATA_SIZE, expanded_data,
+                    DATA_SIZE*2*k, k, msb_first) == false)
+            {
+                printf("Error encoding oversampled data.\n");
+                return false;
+            }
+            for(uint32_t i = 0; i < DATA_SIZE*16*k; i++)
+            {
+                uint32_t chip_i = i / k;
+                uint8_t chip = (encoded_data[chip_i / 8] >> (chip_i % 8)) & 1;
+                uint8_t bit_i = msb_first ? (7 - (i % 8)) : (i % 8);
+                uint8_t bit = (expanded_data[i / 8] >> bit_i) & 1;
+                if(chip != bit)
+                {
+                    printf("Samples per chip %d (%s first) - FAIL!\n", k,
+                           msb_first ? "MSb" : "LSb");
+                    return false;
+                }
+            }
+        }
+    }
+    printf("Ok, expanded data == expanded encode() output.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test capture files import: an encoded frame is dumped as a VCD
+  * text file (imported from file with a small output array emptied through
+  * a callback, and parsed from memory in small pieces) and as a sigrok raw
+  * binary logic dump (with other channels toggling randomly).
+  * @return Test result.
+  */
+bool test4(void)
+{
+    const uint16_t DATA_SIZE = 512;
+    const uint32_t TICKS_PER_CHIP = 40;
+    const char* VCD_FILE = "test_capture.vcd";
+    const char* VCD_LONG_ID = "$scope module top $end\n"
+            "$var wire 1 ! clk $end\n"
+            "$var wire 1 0123456789abcdefgh line $end\n"
+            "$upscope $end\n$enddefinitions $end\n";
+    static uint8_t data[DATA_SIZE] = { 0 };
+    static uint8_t encoded_data[DATA_SIZE*2] = { 0 };
+    static uint64_t edges[DATA_SIZE*16 + 8] = { 0 };
+    static char vcd[DATA_SIZE*16*24] = { 0 };
+    static uint8_t samples[DATA_SIZE*2*9] = { 0 };
+    static uint8_t units[DATA_SIZE*2*9*8] = { 0 };
+    static uint8_t decoded_data[DATA_SIZE] = { 0 };
+    uint8_t small_out[100] = { 0 };
+    size_t num_edges = 0;
+    size_t vcd_len = 0;
+    size_t samples_len = 0;
+    bool result = true;
+    CDP Cdp;
+    static CDPCapture Capture;
+    FILE* file = NULL;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 4:\n\n");
+
+    for(uint32_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+    data[0] |= 0x01;
+    if(Cdp.encode(data, DATA_SIZE, encoded_data, DATA_SIZE*2) == false)
+    {
+        printf("Error encoding data.\n");
+        return false;
+    }
+
+    // Build the VCD text (with an unrelated signal changing too)
+    num_edges = chips_to_edges(encoded_data, DATA_SIZE*16, LOGIC_LEVEL_LOW,
+            1000, TICKS_PER_CHIP, 4, edges, sizeof(edges)/sizeof(edges[0]));
+    vcd_len = sprintf(vcd, "$date today $end\n$timescale 1ns $end\n"
+            "$scope module top $end\n$var wire 1 ! clk $end\n"
+            "$var wire 1 %%a line $end\n$upscope $end\n"
+            "$enddefinitions $end\n$dumpvars\n0!\n0%%a\n$end\n");
+    for(size_t i = 0; i < num_edges; i++)
+    {
+        vcd_len += sprintf(vcd + vcd_len, "#%" PRIu64 "\n%d%%a\n%d!\n",
+                edges[i], (int)((i + 1) % 2), (int)(i % 2));
+    }
+    file = fopen(VCD_FILE, "wb");
+    if(file == NULL)
+    {
+        printf("Error creating VCD file.\n");
+        return false;
+    }
+    fwrite(vcd, 1, vcd_len, file);
+    fclose(file);
+
+    // Import VCD file
+    collect_data(NULL, 0, decoded_data);
+    result = Capture.import_vcd(VCD_FILE, "line", TICKS_PER_CHIP, small_out,
+            sizeof(small_out), collect_data, decoded_data);
+    remove(VCD_FILE);
+    printf("VCD file: %" PRIu64 " edges.\n", Capture.get_num_edges());
+    if((result == false) || (memcmp(decoded_data, data, DATA_SIZE) != 0))
+    {
+        printf("Error, VCD file decoded data != input data.\n\n");
+        return false;
+    }
+
+    // Parse VCD from memory in small pieces
+    memset(decoded_data, 0, DATA_SIZE);
+    Capture.vcd_setup("line", TICKS_PER_CHIP, decoded_data, DATA_SIZE, NULL,
+            NULL);
+    for(size_t i = 0; (i < vcd_len) && result; i += 37)
+    {
+        result = Capture.vcd_parse(vcd + i,
+                (vcd_len - i < 37) ? vcd_len - i : 37);
+    }
+    if((result == false) || (Capture.vcd_flush() == false) ||
+       (memcmp(decoded_data, data, DATA_SIZE) != 0))
+    {
+        printf("Error, VCD text decoded data != input data.\n\n");
+        return false;
+    }
+
+    // Chosen signal with an identifier code too long must not take the
+    // previous variable identifier
+    Capture.vcd_setup("line", TICKS_PER_CHIP, decoded_data, DATA_SIZE, NULL,
+            NULL);
+    if(Capture.vcd_parse(VCD_LONG_ID, strlen(VCD_LONG_ID)))
+    {
+        printf("Error, VCD signal with too long identifier found.\n\n");
+        return false;
+    }
+
+    // Build sigrok binary dump (channel 3) and parse it in pieces
+    samples_len = oversample_chips(encoded_data, DATA_SIZE*16, 8.0, 0.01,
+            samples, sizeof(samples));
+    for(size_t i = 0; i < samples_len*8; i++)
+    {
+        units[i] = gen_random_byte() & ~0x08;
+        units[i] |= ((samples[i / 8] >> (i % 8)) & 0x01) << 3;
+    }
+    memset(decoded_data, 0, DATA_SIZE);
+    Capture.sigrok_setup(1, 3, 8.0, decoded_data, DATA_SIZE, NULL, NULL);
+    for(size_t i = 0; (i < samples_len*8) && result; i += 1001)
+    {
+        result = Capture.sigrok_parse(units + i,
+                (samples_len*8 - i < 1001) ? samples_len*8 - i : 1001);
+    }
+    if((Capture.sigrok_flush() == false) ||
+       (memcmp(decoded_data, data, DATA_SIZE) != 0))
+    {
+        printf("Error, sigrok decoded data != input data.\n\n");
+        return false;
+    }
+    printf("Ok, decoded data == input data.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test edge timestamps decode: two encoded frames separated by idle
+  * line are converted to jittered edge timestamps (as 64 bits, as 32 bits
+  * wrapping around and as 64 bits with a huge idle gap between frames) and
+  * decoded back without expanding them to chips. Frames with first chip
+  * opposite to the idle line and at the idle line level (no start edge) are
+  * tested.
+  * @return Test result.
+  */
+bool test3(void)
+{
+    const uint16_t FRAME_SIZE = 256;
+    const uint32_t TICKS_PER_CHIP = 25;
+    static uint8_t data[FRAME_SIZE*2] = { 0 };
+    static uint8_t encoded_data[FRAME_SIZE*2] = { 0 };
+    static uint64_t edges[FRAME_SIZE*2*16 + 8] = { 0 };
+    static uint32_t edges32[FRAME_SIZE*2*16 + 8] = { 0 };
+    static uint8_t decoded_data[FRAME_SIZE*2] = { 0 };
+    CDP Cdp;
+    CDPEdges Edges;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 3:\n\n");
+
+    for(uint8_t first_bit = 0; first_bit < 2; first_bit++)
+    {
+        size_t num_edges = 0;
+        size_t first_frame_edges = 0;
+        uint8_t first_chip_level = LOGIC_LEVEL_LOW;
+
+        // Build two frames (first bit 1 leaves the idle LOW line with the
+        // first chip, first bit 0 keeps it LOW for the first chip)
+        for(uint32_t i = 0; i < FRAME_SIZE*2; i++)
+            data[i] = gen_random_byte();
+        data[0] = (data[0] & 0xFE) | first_bit;
+        data[FRAME_SIZE] = (data[FRAME_SIZE] & 0xFE) | first_bit;
+        for(uint8_t n = 0; n < 2; n++)
+        {
+            if(Cdp.encode(data + n*FRAME_SIZE, FRAME_SIZE, encoded_data,
+                    FRAME_SIZE*2) == false)
+            {
+                printf("Error encoding data.\n");
+                return false;
+            }
+            first_chip_level = encoded_data[0] & 0x01;
+            num_edges += chips_to_edges(encoded_data, FRAME_SIZE*16,
+                    LOGIC_LEVEL_LOW, 0xFFFF0000ULL + n*FRAME_SIZE*16*40,
+                    TICKS_PER_CHIP, 3, edges + num_edges,
+                    (sizeof(edges)/sizeof(edges[0])) - num_edges);
+            if(n == 0)
+                first_frame_edges = num_edges;
+        }
+        for(size_t i = 0; i < num_edges; i++)
+            edges32[i] = (uint32_t)edges[i];
+
+        // Decode 64 bits timestamps in two pieces, 32 bits ones at once,
+        // and 64 bits ones with a 2^48 ticks gap (fixed point overflow) at
+        // once
+        for(uint8_t n = 0; n < 3; n++)
+        {
+            bool result = false;
+            memset(decoded_data, 0, sizeof(decoded_data));
+            Edges.setup(TICKS_PER_CHIP, LOGIC_LEVEL_LOW, first_chip_level,
+                    decoded_data, sizeof(decoded_data), NULL, NULL);
+            if(n == 0)
+            {
+                result = Edges.decode(edges, num_edges/2) &&
+                         Edges.decode(edges + num_edges/2,
+                                 num_edges - num_edges/2);
+            }
+            else if(n == 1)
+                result = Edges.decode(edges32, num_edges);
+            else
+            {
+                // Gap that wraps to a single chip if shifted without
+                // clamping
+                uint64_t gap = (1ULL << 48) + TICKS_PER_CHIP -
+                        (edges[first_frame_edges] -
+                         edges[first_frame_edges-1]);
+                for(size_t i = first_frame_edges; i < num_edges; i++)
+                    edges[i] = edges[i] + gap;
+                result = Edges.decode(edges, num_edges);
+            }
+            if((result == false) || (Edges.flush() == false))
+            {
+                printf("Error decoding edges.\n");
+                return false;
+            }
+            printf("First chip %s, %d bits timestamps%s: %zu edges, %zu "
+                   "bytes decoded.\n", first_bit ? "HIGH" : "LOW",
+                   (n == 1) ? 32 : 64, (n == 2) ? " (huge gap)" : "",
+                   num_edges, Edges.get_decoded_len());
+            if((Edges.get_decoded_len() != FRAME_SIZE*2) ||
+               (memcmp(decoded_data, data, FRAME_SIZE*2) != 0))
+            {
+                printf("Error, decoded data != input data.\n\n");
+                return false;
+            }
+        }
+    }
+    printf("Ok, decoded data == input data.\n\n");
+
+    return true;
+}
+
+/**
+  * @brief  Test oversampled capture decode: encode 2048 bytes, oversample
+  * the chips at different ratios with a drifting clock and check that the
+  * digital PLL decoder recovers the original data.
+  * @return Test result.
+  */
+bool test2(void)
+{
+    const uint16_t DATA_SIZE = 2048;
+    const double RATIOS[] = { 4.0, 7.3, 16.0 };
+    static uint8_t data[DATA_SIZE] = { 0 };
+    static uint8_t encoded_data[DATA_SIZE*2] = { 0 };
+    static uint8_t samples[DATA_SIZE*2*17] = { 0 };
+    static uint8_t decoded_data[DATA_SIZE] = { 0 };
+    CDP Cdp;
+    CDPOversampled Oversampled;
+
+    printf("\n\n--------------------------------\n\n");
+    printf("TEST 2:\n\n");
+
+    for(uint32_t i = 0; i < DATA_SIZE; i++)
+        data[i] = gen_random_byte();
+    if(Cdp.encode(data, DATA_SIZE, encoded_data, DATA_SIZE*2) == false)
+    {
+        printf("Error encoding data.\n");
+        return false;
+    }
+
+    for(uint8_t n = 0; n < sizeof(RATIOS)/sizeof(RATIOS[0]); n++)
+    {
+        size_t samples_len = oversample_chips(encoded_data, DATA_SIZE*16,
+                RATIOS[n], 0.02, samples, sizeof(samples));
+
+        // Decode the capture in two pieces to check streaming
+        memset(decoded_data, 0, DATA_SIZE);
+        Oversampled.setup(RATIOS[n], decoded_data, DATA_SIZE, NULL, NULL);
+        if((Oversampled.decode(samples, samples_len/2) == false) ||
+           (Oversampled.decode(samples + samples_len/2,
+                samples_len - samples_len/2) == false))
+        {
+            printf("Error decoding oversampled data.\n");
+            return false;
+        }
+        printf("Samples per chip %.1f: %zu bytes decoded (recovered "
+               "%.3f).\n", RATIOS[n], Oversampled.get_decoded_len(),
+               Oversampled.get_samples_per_chip());
+        if((Oversampled.get_decoded_len() < DATA_SIZE) ||
+           (memcmp(decoded_data, data, DATA_SIZE) != 0))
+        {
+            printf("Error, decoded data != input data.\n\n");
+            return false;
+        }
+    }
+    printf("Ok, decoded data == input data.\n\n");
+
+    return true;
+}
+
 /**
   * @brief  Test encode-decode for 4096 bytes and compare decode result
   * with initial data to check if anything goes wrong.
@@ -200,6 +2656,122 @@ bool test0(void)
 
 /* Auxiliar Functions */
 
+/**
+  * @brief  Simulate a logic analyzer capture of a chips stream, sampling
+  * it with a clock that drifts sinusoidally around the nominal ratio.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips.
+  * @param  samples_per_chip Nominal number of samples per chip.
+  * @param  drift Maximum relative clock drift (i.e. 0.02 for 2%).
+  * @param  samples Pointer to output packed samples array (LSB-first).
+  * @param  samples_len Number of bytes of the output samples array.
+  * @return Number of bytes of samples generated.
+  */
+size_t oversample_chips(const uint8_t* chips, const size_t num_chips,
+        const double samples_per_chip, const double drift,
+        uint8_t* samples, const size_t samples_len)
+{
+    double chip_position = 0.0;
+    size_t sample_i = 0;
+
+    memset(samples, 0, samples_len);
+    while(sample_i < samples_len*8)
+    {
+        size_t chip_i = (size_t)chip_position;
+        if(chip_i >= num_chips)
+            break;
+        if((chips[chip_i / 8] >> (chip_i % 8)) & 0x01)
+            samples[sample_i / 8] |= (1 << (sample_i % 8));
+        chip_position = chip_position + 1.0 / (samples_per_chip *
+                (1.0 + drift * sin(chip_position / 3000.0)));
+        sample_i = sample_i + 1;
+    }
+
+    return (sample_i + 7) / 8;
+}
+
+/**
+  * @brief  Convert a chips stream to the list of timestamps of its edges,
+  * as a capture tool would store it, with random jitter on each edge. The
+  * line starts and ends at idle level.
+  * @param  chips Pointer to packed chips (LSB-first).
+  * @param  num_chips Number of chips.
+  * @param  idle_level Line level before and after the chips.
+  * @param  start_time Timestamp of the start of the first chip.
+  * @param  ticks_per_chip Chip duration in timestamp ticks.
+  * @param  jitter Maximum edge jitter in ticks.
+  * @param  edges Pointer to output edge timestamps array.
+  * @param  edges_len Number of elements of the output edges array.
+  * @return Number of edge timestamps generated.
+  */
+size_t chips_to_edges(const uint8_t* chips, const size_t num_chips,
+        const uint8_t idle_level, const uint64_t start_time,
+        const uint32_t ticks_per_chip, const uint32_t jitter,
+        uint64_t* edges, const size_t edges_len)
+{
+    uint8_t level = idle_level;
+    size_t num_edges = 0;
+
+    for(size_t i = 0; i <= num_chips; i++)
+    {
+        uint8_t chip = idle_level;
+        if(i < num_chips)
+            chip = (chips[i / 8] >> (i % 8)) & 0x01;
+        if((chip == level) || (num_edges >= edges_len))
+            continue;
+        edges[num_edges] = start_time + (i * ticks_per_chip) +
+                (rand() % (2*jitter + 1)) - jitter;
+        num_edges = num_edges + 1;
+        level = chip;
+    }
+
+    return num_edges;
+}
+
+/**
+  * @brief  Append chips to a packed chips stream at any chip position.
+  * @param  chips Pointer to packed chips stream (LSB-first).
+  * @param  num_chips Number of chips already in the stream.
+  * @param  chips_in Pointer to packed chips to append (LSB-first).
+  * @param  chips_in_len Number of chips to append.
+  * @return Number of chips of the stream after the append.
+  */
+uint64_t append_chips(uint8_t* chips, uint64_t num_chips,
+        const uint8_t* chips_in, const uint64_t chips_in_len)
+{
+    for(uint64_t i = 0; i < chips_in_len; i++)
+    {
+        uint8_t chip = (chips_in[i / 8] >> (i % 8)) & 0x01;
+        if(chip)
+            chips[num_chips / 8] |= (1 << (num_chips % 8));
+        else
+            chips[num_chips / 8] &= ~(1 << (num_chips % 8));
+        num_chips = num_chips + 1;
+    }
+
+    return num_chips;
+}
+
+/**
+  * @brief  Decoders output callback that appends decoded data to the array
+  * given as argument (a NULL data pointer restarts the array position).
+  * @param  data Pointer to decoded data.
+  * @param  data_len Number of decoded bytes.
+  * @param  arg Pointer to the array to append the data.
+  */
+void collect_data(const uint8_t* data, const size_t data_len, void* arg)
+{
+    static size_t data_i = 0;
+
+    if(data == NULL)
+    {
+        data_i = 0;
+        return;
+    }
+    memcpy((uint8_t*)arg + data_i, data, data_len);
+    data_i = data_i + data_len;
+}
+
 /**
   * @brief  Generate a pseudo-random byte value.
   * @return Generated random byte value.
@@ -217,3 +2789,122 @@ uint8_t gen_random_byte(void)
     // Return the generated byte value
     return ((uint8_t)(rand()));
 }
+
+/**
+  * @brief  Encode data bit by bit with the transitions rules of a line
+  * code (reference for the line codes family test).
+  * @param  code Line code (LINE_CODE_x).
+  * @param  convention Transition convention (LINE_CONVENTION_x).
+  * @param  bit_order Bits and chips order (LINE_BIT_ORDER_x).
+  * @param  level Signal level before the data.
+  * @param  data Pointer to data to encode.
+  * @param  data_len Number of bytes of data.
+  * @param  chips Pointer to output chips (data_len*2 bytes).
+  */
+void line_code_encode_ref(const uint8_t code, const uint8_t convention,
+        const uint8_t bit_order, uint8_t level, const uint8_t* data,
+        const size_t data_len, uint8_t* chips)
+{
+    const uint8_t marked_bit = (convention == LINE_CONVENTION_INVERTED);
+    size_t chip_n = 0;
+
+    memset(chips, 0, data_len*2);
+    for(size_t i = 0; i < data_len*8; i++)
+    {
+        uint8_t bit_n = (bit_order == LINE_BIT_ORDER_LSB_FIRST) ? (i % 8) :
+                (7 - (i % 8));
+        uint8_t bit = (data[i / 8] >> bit_n) & 0x01;
+        uint8_t chip[2];
+
+        if(code == LINE_CODE_DIFF_MANCHESTER)
+        {
+            // Transition at start for 0 bits (1 bits if inverted)
+            chip[0] = (bit == marked_bit) ? !level : level;
+            chip[1] = !chip[0];
+        }
+        else if(code == LINE_CODE_MANCHESTER)
+        {
+            // 0 bits as "10" and 1 bits as "01" (the opposite if inverted)
+            chip[0] = (bit == marked_bit) ? 1 : 0;
+            chip[1] = !chip[0];
+        }
+        else
+        {
+            // Transition at start always, middle transition for 0 bits
+            // (1 bits if inverted)
+            chip[0] = !level;
+            chip[1] = (bit == marked_bit) ? !chip[0] : chip[0];
+        }
+        level = chip[1];
+
+        for(uint8_t k = 0; k < 2; k++)
+        {
+            uint8_t chip_bit_n = (bit_order == LINE_BIT_ORDER_LSB_FIRST) ?
+                    (chip_n % 8) : (7 - (chip_n % 8));
+            chips[chip_n / 8] |= (uint8_t)(chip[k] << chip_bit_n);
+            chip_n = chip_n + 1;
+        }
+    }
+}
+
+/**
+  * @brief  Check a line code of the family: encode must be the same as the
+  * reference encoder (from the initial level, and in two pieces from the
+  * other level), and decode must give the data back.
+  * @param  data Pointer to data to encode.
+  * @param  data_len Number of bytes of data.
+  * @return Check result.
+  */
+template <uint8_t CODE, uint8_t CONVENTION, uint8_t BIT_ORDER,
+        uint8_t INITIAL_LEVEL>
+bool check_line_code(const uint8_t* data, const size_t data_len)
+{
+    const char* NAMES[] = { "Differential Manchester", "Manchester",
+            "Biphase" };
+    static uint8_t encoded_data[8192*2];
+    static uint8_t encoded_ref[8192*2];
+    static uint8_t decoded_data[8192];
+    CDPLineCode<CODE, CONVENTION, BIT_ORDER, INITIAL_LEVEL> Line;
+    const size_t split = (size_t)rand() % data_len;
+    uint8_t level = !INITIAL_LEVEL;
+    uint8_t decode_level = !INITIAL_LEVEL;
+
+    printf("%s, %s convention, %s first, initial %s: ", NAMES[CODE],
+            (CONVENTION == LINE_CONVENTION_NORMAL) ? "normal" : "inverted",
+            (BIT_ORDER == LINE_BIT_ORDER_LSB_FIRST) ? "LSb" : "MSb",
+            (INITIAL_LEVEL == LOGIC_LEVEL_HIGH) ? "HIGH" : "LOW");
+
+    // From the initial level
+    line_code_encode_ref(CODE, CONVENTION, BIT_ORDER, INITIAL_LEVEL, data,
+            data_len, encoded_ref);
+    Line.encode(data, data_len, encoded_data, sizeof(encoded_data));
+    Line.decode(encoded_data, data_len*2, decoded_data, sizeof(decoded_data));
+    if((memcmp(encoded_data, encoded_ref, data_len*2) != 0) ||
+       (memcmp(decoded_data, data, data_len) != 0))
+    {
+        printf("FAIL!\n");
+        return false;
+    }
+
+    // In two pieces from the other level
+    line_code_encode_ref(CODE, CONVENTION, BIT_ORDER, !INITIAL_LEVEL, data,
+            data_len, encoded_ref);
+    Line.encode(data, split, encoded_data, sizeof(encoded_data), &level);
+    Line.encode(data + split, data_len - split, encoded_data + split*2,
+            sizeof(encoded_data) - split*2, &level);
+    Line.decode(encoded_data, split*2, decoded_data, sizeof(decoded_data),
+            &decode_level);
+    Line.decode(encoded_data + split*2, (data_len - split)*2,
+            decoded_data + split, sizeof(decoded_data) - split,
+            &decode_level);
+    if((memcmp(encoded_data, encoded_ref, data_len*2) != 0) ||
+       (memcmp(decoded_data, data, data_len) != 0) ||
+       (level != decode_level))
+    {
+        printf("FAIL!\n");
+        return false;
+    }
+    printf("Ok.\n");
+
+    return true;
+}